@@ -163,6 +163,7 @@ ENDMACRO ()
 MACRO (SETUP_LAUNCHERS)
 	SETUP_GAME_LAUNCHER (NAME Game CLASS ClientApplication ICON Client.ico CLIENT)
 	SETUP_GAME_LAUNCHER (NAME Server CLASS ServerApplication ICON Server.ico HEADLESS)
+	SETUP_GAME_LAUNCHER (NAME LoadTest CLASS LoadTestApplication ICON Server.ico HEADLESS)
 	
 	# TODO: Handle U3S source installation directory
 	DEFINE_RESOURCE_DIRS (GLOB_PATTERNS ${CMAKE_SOURCE_DIR}/Assets/Editor)
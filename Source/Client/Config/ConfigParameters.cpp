@@ -25,9 +25,11 @@
 #include <Urho3D/Core/StringUtils.h>
 #include <Urho3D/Engine/EngineDefs.h>
 #include <Urho3D/Graphics/Graphics.h>
+#include <Urho3D/Graphics/GraphicsEvents.h>
 #include <Urho3D/Graphics/Renderer.h>
 #include <Urho3D/IO/Log.h>
 #include <Urho3D/Resource/Localization.h>
+#include <Urho3D/Resource/ResourceEvents.h>
 #include "Config/Config.h"
 #include "Config/ConfigDefs.h"
 
@@ -70,6 +72,8 @@ void RegisterClientParameters(Config* config)
 				}
 				return ret;
 			});
+		// Code loading language packs later has to call InvalidateEnum(CP_LANGUAGE) itself
+		config->InvalidateEnumOn(E_CHANGELANGUAGE, CP_LANGUAGE);
 
 		config->RegisterSimpleEnumParameter(
 			EP_LOG_LEVEL,
@@ -319,6 +323,11 @@ void RegisterClientParameters(Config* config)
 			[config]() { return config->GetSubsystem<Renderer>()->GetShadowMapSize(); },
 			[config](const Variant& value) { config->GetSubsystem<Renderer>()->SetShadowMapSize(value.GetInt()); },
 			{{"256x256", 256}, {"512x512", 512}, {"1024x1024", 1024}, {"2048x2048", 2048}, {"4096x4096", 4096}});
+
+		// Available modes depend on current monitor and graphics backend
+		config->InvalidateEnumOn(E_SCREENMODE, ECP_RESOLUTION);
+		config->InvalidateEnumOn(E_SCREENMODE, EP_MONITOR);
+		config->InvalidateEnumOn(E_SCREENMODE, EP_MULTI_SAMPLE);
 	}
 
 	config->RegisterSettingsTab(ST_AUDIO);
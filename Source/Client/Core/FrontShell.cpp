@@ -41,6 +41,7 @@
 #include "Input/ControllersRegistry.h"
 #include "Plugin/PluginsRegistry.h"
 #include "UI/LoadGameDialog.h"
+#include "UI/LoadingDialog.h"
 #include "UI/MainMenuDialog.h"
 #include "UI/NewGameDialog.h"
 #include "UI/PauseDialog.h"
@@ -64,6 +65,7 @@ FrontShell::FrontShell(Urho3D::Context* context)
 #endif // URHO3D_ANGELSCRIPT
 
 	context_->RegisterFactory<LoadGameDialog>();
+	context_->RegisterFactory<LoadingDialog>();
 	context_->RegisterFactory<MainMenuDialog>();
 	context_->RegisterFactory<NewGameDialog>();
 	context_->RegisterFactory<PauseDialog>();
@@ -98,9 +100,15 @@ void FrontShell::InitInput()
 	SendEvent(E_SHELLCLIENTSTARTED);
 
 	controllers->Enable("KeyboardController");
+	controllers->Enable("JoystickController");
 }
 
-void FrontShell::StartMainMenu() { GetSubsystem<FrontStateMachine>()->Initialize<MainMenuState>(); }
+// Settings dialog should not stall on querying display modes when opened first time
+void FrontShell::StartMainMenu()
+{
+	GetSubsystem<Config>()->PrecomputeEnums();
+	GetSubsystem<FrontStateMachine>()->Initialize<MainMenuState>();
+}
 
 void FrontShell::StartLocalServer(const Urho3D::String& sceneName)
 {
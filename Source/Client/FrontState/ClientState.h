@@ -36,6 +36,9 @@ public:
 	void Enter() override;
 	void Exit() override;
 
+	bool StartRecording(const Urho3D::String& name) { return client_.StartRecording(name); }
+	void StopRecording() { client_.StopRecording(); }
+
 private:
 	// On Shutdown
 	void OnServerDisconnected(Urho3D::StringHash, Urho3D::VariantMap&);
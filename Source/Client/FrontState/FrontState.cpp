@@ -32,6 +32,7 @@
 #include <Urho3D/UI/UIEvents.h>
 #include "FrontState.h"
 #include "FrontStateMachine.h"
+#include "Network/NetworkStats.h"
 
 using namespace Urho3D;
 
@@ -213,6 +214,13 @@ void FrontState::ToggleConsole()
 		DecInteractives();
 }
 
+void FrontState::ToggleDebugHud()
+{
+	DebugHud* debugHud = GetSubsystem<DebugHud>();
+	debugHud->ToggleAll();
+	GetSubsystem<NetworkStats>()->SetDebugHud(debugHud->GetMode() != DEBUGHUD_SHOW_NONE);
+}
+
 void FrontState::OnKeyDown(Urho3D::StringHash, Urho3D::VariantMap& eventData)
 {
 	using namespace KeyDown;
@@ -224,6 +232,9 @@ void FrontState::OnKeyDown(Urho3D::StringHash, Urho3D::VariantMap& eventData)
 	case KEY_F1:
 		ToggleConsole();
 		break;
+	case KEY_F2:
+		ToggleDebugHud();
+		break;
 	}
 }
 
@@ -34,9 +34,14 @@ LocalServerState::LocalServerState(Urho3D::Context* context, const Urho3D::Strin
 
 void LocalServerState::Exit()
 {
+	// Scene could fail to load, then client has never connected and there is nothing to wait for
+	const bool connected = client_.IsConnected();
 	client_.Disconnect();
 	server_.Stop();
-	SubscribeToEvent(E_SERVERDISCONNECTED, URHO3D_HANDLER(LocalServerState, OnServerDisconnected));
+	if (connected)
+		SubscribeToEvent(E_SERVERDISCONNECTED, URHO3D_HANDLER(LocalServerState, OnServerDisconnected));
+	else
+		ReleaseSelf();
 }
 
 void LocalServerState::OnSceneLoaded()
@@ -39,6 +39,9 @@ public:
 
 	void Exit() override;
 
+	bool StartRecording(const Urho3D::String& name) { return client_.StartRecording(name); }
+	void StopRecording() { client_.StopRecording(); }
+
 protected:
 	void OnSceneLoaded() override;
 
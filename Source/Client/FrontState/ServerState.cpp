@@ -20,7 +20,10 @@
 // THE SOFTWARE.
 //
 
+#include <Urho3D/Core/CoreEvents.h>
 #include <Urho3D/Scene/SceneEvents.h>
+#include "FrontStateMachine.h"
+#include "MainMenuState.h"
 #include "ServerState.h"
 
 using namespace Urho3D;
@@ -34,7 +37,14 @@ ServerState::ServerState(Urho3D::Context* context, const Urho3D::String& sceneNa
 
 void ServerState::Enter()
 {
-	server_.LoadScene(sceneName_);
+	CreateDialog("LoadingDialog");
+	if (!server_.LoadScene(sceneName_))
+	{
+		// State is being entered, so it is left on next frame
+		RemoveAllDialogs();
+		SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(ServerState, OnLoadFailed));
+		return;
+	}
 	SubscribeToEvent(E_ASYNCLOADFINISHED, URHO3D_HANDLER(ServerState, OnAsyncLoadFinished));
 }
 
@@ -46,3 +56,12 @@ void ServerState::OnAsyncLoadFinished(Urho3D::StringHash, Urho3D::VariantMap&)
 	RemoveAllDialogs();
 	UnsubscribeFromEvent(E_ASYNCLOADFINISHED);
 }
+
+void ServerState::OnLoadFailed(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	UnsubscribeFromEvent(E_BEGINFRAME);
+	// This state is released during Push, only the new one is used afterwards
+	SharedPtr<FrontState> menu(new MainMenuState(context_));
+	GetSubsystem<FrontStateMachine>()->Push(menu);
+	menu->ShowErrorMessage("SceneLoadFailedText", "SceneLoadFailedTitle");
+}
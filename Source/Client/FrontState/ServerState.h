@@ -35,6 +35,11 @@ public:
 
 	void Enter() override;
 
+	bool RestartScene() { return server_.RestartScene(); }
+	bool SaveGame(const Urho3D::String& name) { return server_.SaveGame(name); }
+	bool StartReplay(unsigned playerId, const Urho3D::String& name) { return server_.StartReplay(playerId, name); }
+	void StopReplay(unsigned playerId) { server_.StopReplay(playerId); }
+
 protected:
 	virtual void OnSceneLoaded() = 0;
 
@@ -46,6 +51,7 @@ protected:
 private:
 	// On Start
 	void OnAsyncLoadFinished(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnLoadFailed(Urho3D::StringHash, Urho3D::VariantMap&);
 };
 
 #endif // SERVERSTATE_H
@@ -22,10 +22,10 @@
 
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/IO/Log.h>
-#include <Urho3D/Input/Controls.h>
 #include <Urho3D/Resource/XMLFile.h>
 #include "ControllersRegistry.h"
 #include "Core/ShellConfigurator.h"
+#include "JoystickController.h"
 #include "KeyboardController.h"
 
 using namespace Urho3D;
@@ -34,7 +34,9 @@ ControllersRegistry::ControllersRegistry(Urho3D::Context* context)
 	: Object(context)
 {
 	context_->RegisterFactory<KeyboardController>();
+	context_->RegisterFactory<JoystickController>();
 	Register<KeyboardController>();
+	Register<JoystickController>();
 }
 
 ControllersRegistry::~ControllersRegistry()
@@ -43,10 +45,11 @@ ControllersRegistry::~ControllersRegistry()
 		DisableImpl(p.second_);
 }
 
-void ControllersRegistry::ReadControls(Urho3D::Controls& controls) const
+void ControllersRegistry::ReadControls(InputFrame& frame) const
 {
+	frame.ClearAxes(); // Axes are absolute, actions accumulate until sent
 	for (const auto& p : enabledControllers_)
-		p.second_->ReadControls(controls);
+		p.second_->ReadControls(frame);
 }
 
 void ControllersRegistry::Register(Urho3D::SharedPtr<InputController> controller)
@@ -40,7 +40,7 @@ public:
 	explicit ControllersRegistry(Urho3D::Context* context);
 	~ControllersRegistry();
 
-	void ReadControls(Urho3D::Controls& controls) const;
+	void ReadControls(InputFrame& frame) const;
 
 	void Register(Urho3D::SharedPtr<InputController> controller);
 	void Remove(Urho3D::StringHash controllerType);
@@ -22,6 +22,7 @@
 
 #include <Urho3D/Container/HashSet.h>
 #include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/IO/Log.h>
 #include <Urho3D/Resource/XMLElement.h>
 #include "ControllersRegistry.h"
 #include "Input/ActionsRegistry.h"
@@ -54,16 +55,11 @@ bool InputController::LoadXML(const Urho3D::XMLElement& source)
 	for (const auto& p : defaultBindings_)
 		unboundActions_.Insert(p.first_);
 
-	ActionsRegistry* actions = GetSubsystem<ActionsRegistry>();
 	StringHash action;
-	unsigned keyCode;
-	for (XMLElement binding = source.GetChild("binding"); !binding.IsNull(); binding = binding.GetNext())
+	for (XMLElement binding = source.GetChild("binding"); !binding.IsNull(); binding = binding.GetNext("binding"))
 	{
-		keyCode = GetKeyCode(binding.GetAttribute("key"));
 		action = binding.GetAttribute("action");
-		bindings_[keyCode] = action;
-		if (actions->IsRemote(action))
-			remoteBindings_.Push(MakePair(keyCode, actions->GetFlag(action)));
+		SetBinding(action, GetKeyCode(binding.GetAttribute("key")));
 		unboundActions_.Erase(action);
 	}
 
@@ -72,9 +68,20 @@ bool InputController::LoadXML(const Urho3D::XMLElement& source)
 	{
 		it = defaultBindings_.Find(p);
 		if (it != defaultBindings_.End())
-			bindings_[it->second_] = it->first_;
+			SetBinding(it->first_, it->second_);
 	}
 
+	HashSet<StringHash> boundAxes;
+	for (XMLElement axis = source.GetChild("axis"); !axis.IsNull(); axis = axis.GetNext("axis"))
+	{
+		action = axis.GetAttribute("action");
+		SetAxisBinding(action, GetKeyCode(axis.GetAttribute("key")), axis.GetFloat("scale"));
+		boundAxes.Insert(action);
+	}
+	for (const AxisBinding& binding : defaultAxisBindings_)
+		if (!boundAxes.Contains(binding.action_))
+			SetAxisBinding(binding.action_, binding.keyCode_, binding.scale_);
+
 	return true;
 }
 
@@ -90,42 +97,107 @@ void InputController::SaveXML(Urho3D::XMLElement& dst) const
 	XMLElement binding;
 	for (const auto& p : bindings_)
 	{
-		action = &inputRegistry->GetName(p.second_);
-		keyName = GetKeyName(p.first_);
+		action = &inputRegistry->GetName(p.first_);
+		keyName = GetKeyName(p.second_);
 		binding = dst.CreateChild("binding");
 		binding.SetAttribute("key", keyName);
 		binding.SetAttribute("action", *action);
 	}
+
+	for (const AxisBinding& p : axisBindings_)
+	{
+		binding = dst.CreateChild("axis");
+		binding.SetAttribute("key", GetKeyName(p.keyCode_));
+		binding.SetAttribute("action", inputRegistry->GetName(p.action_));
+		binding.SetFloat("scale", p.scale_);
+	}
 }
 
 void InputController::SetBinding(Urho3D::StringHash action, unsigned keyCode)
 {
+	const unsigned index = GetKeyIndex(keyCode);
+	if (index == M_MAX_UNSIGNED)
+	{
+		URHO3D_LOGWARNINGF(
+			"%s: key %s can not be bound to action", GetTypeName().CString(), GetKeyName(keyCode).CString());
+		return;
+	}
+
+	RemoveBinding(action);
+	if (index < keys_.Size())
+		RemoveBinding(keys_[index].action_);
+	else
+	{
+		const unsigned size = keys_.Size();
+		keys_.Resize(index + 1);
+		for (unsigned i = size; i < keys_.Size(); ++i)
+			keys_[i] = {StringHash::ZERO, M_MAX_UNSIGNED};
+	}
+
+	KeySlot& slot = keys_[index];
+	slot.action_ = action;
+	bindings_[action] = keyCode;
+
 	const ActionsRegistry* actions = GetSubsystem<ActionsRegistry>();
 	if (actions->IsRemote(action))
 	{
-		const unsigned actionFlag = actions->GetFlag(action);
-		for (auto it = remoteBindings_.Begin(); it != remoteBindings_.End();)
-			if (it->first_ == keyCode || it->second_ == actionFlag)
-				it = remoteBindings_.Erase(it);
-			else
-				++it;
-		remoteBindings_.Push(MakePair(keyCode, actionFlag));
+		slot.remote_ = remoteKeys_.Size();
+		remoteKeys_.Push(keyCode);
+		remoteFlags_.Push(actions->GetFlag(action));
+	}
+}
+
+void InputController::RemoveBinding(Urho3D::StringHash action)
+{
+	const auto it = bindings_.Find(action);
+	if (it == bindings_.End())
+		return;
+
+	KeySlot& slot = keys_[GetKeyIndex(it->second_)];
+	if (slot.remote_ != M_MAX_UNSIGNED)
+	{
+		// Move last remote binding into the hole to keep arrays packed
+		const unsigned last = remoteKeys_.Size() - 1;
+		remoteKeys_[slot.remote_] = remoteKeys_[last];
+		remoteFlags_[slot.remote_] = remoteFlags_[last];
+		keys_[GetKeyIndex(remoteKeys_[last])].remote_ = slot.remote_;
+		remoteKeys_.Pop();
+		remoteFlags_.Pop();
 	}
-	for (auto it = bindings_.Begin(); it != bindings_.End(); ++it)
-		if (it->second_ == action)
+	slot = {StringHash::ZERO, M_MAX_UNSIGNED};
+	bindings_.Erase(it);
+}
+
+void InputController::SetAxisBinding(Urho3D::StringHash action, unsigned keyCode, float scale)
+{
+	RemoveAxisBinding(keyCode);
+	axisBindings_.Push({keyCode, action, GetSubsystem<ActionsRegistry>()->GetAxis(action), scale});
+}
+
+void InputController::RemoveAxisBinding(unsigned keyCode)
+{
+	for (auto it = axisBindings_.Begin(); it != axisBindings_.End();)
+		if (it->keyCode_ == keyCode)
+			it = axisBindings_.Erase(it);
+		else
+			++it;
+}
+
+void InputController::SetDefaultAxisBinding(Urho3D::StringHash action, unsigned keyCode, float scale)
+{
+	for (auto it = defaultAxisBindings_.Begin(); it != defaultAxisBindings_.End(); ++it)
+		if (it->keyCode_ == keyCode)
 		{
-			bindings_.Erase(it);
+			defaultAxisBindings_.Erase(it);
 			break;
 		}
-	bindings_[keyCode] = action;
+	defaultAxisBindings_.Push({keyCode, action, {InputFrame::MAX_AXES, false}, scale});
 }
 
 unsigned InputController::GetBindingKey(Urho3D::StringHash action) const
 {
-	for (auto it = bindings_.Begin(); it != bindings_.End(); ++it)
-		if (it->second_ == action)
-			return it->first_;
-	return 0;
+	const auto it = bindings_.Find(action);
+	return it != bindings_.End() ? it->second_ : 0;
 }
 
 unsigned InputController::GetDefaultBinding(Urho3D::StringHash action) const
@@ -137,26 +209,32 @@ unsigned InputController::GetDefaultBinding(Urho3D::StringHash action) const
 void InputController::EnableSelf() { GetSubsystem<ControllersRegistry>()->Enable(GetType()); }
 void InputController::DisableSelf() { GetSubsystem<ControllersRegistry>()->Enable(GetType()); }
 
+Urho3D::StringHash InputController::GetKeyAction(unsigned keyCode) const
+{
+	const unsigned index = GetKeyIndex(keyCode);
+	return index < keys_.Size() ? keys_[index].action_ : StringHash::ZERO;
+}
+
 void InputController::SendActionDown(unsigned keyCode)
 {
-	const auto it = bindings_.Find(keyCode);
-	if (it != bindings_.End())
+	const StringHash action = GetKeyAction(keyCode);
+	if (action != StringHash::ZERO)
 	{
 		using namespace ActionDown;
 		VariantMap& eventData = GetEventDataMap();
-		eventData[P_ACTION] = it->second_;
+		eventData[P_ACTION] = action;
 		SendEvent(E_ACTIONDOWN, eventData);
 	}
 }
 
 void InputController::SendActionUp(unsigned keyCode)
 {
-	const auto it = bindings_.Find(keyCode);
-	if (it != bindings_.End())
+	const StringHash action = GetKeyAction(keyCode);
+	if (action != StringHash::ZERO)
 	{
 		using namespace ActionDown;
 		VariantMap& eventData = GetEventDataMap();
-		eventData[P_ACTION] = it->second_;
+		eventData[P_ACTION] = action;
 		SendEvent(E_ACTIONUP, eventData);
 	}
 }
@@ -176,8 +254,15 @@ Urho3D::String InputController::GetDebugString() const
 	ret.Append("\tBindings:\n");
 	for (const auto& p : GetBindings())
 	{
-		ret.Append("\t\tAction: ").Append(actions->GetName(p.second_)).Append("\n");
-		ret.Append("\t\tKey:    ").Append(GetKeyName(p.first_)).Append("\n");
+		ret.Append("\t\tAction: ").Append(actions->GetName(p.first_)).Append("\n");
+		ret.Append("\t\tKey:    ").Append(GetKeyName(p.second_)).Append("\n");
+	}
+	ret.Append("\tAxis bindings:\n");
+	for (const AxisBinding& p : axisBindings_)
+	{
+		ret.Append("\t\tAction: ").Append(actions->GetName(p.action_)).Append("\n");
+		ret.Append("\t\tKey:    ").Append(GetKeyName(p.keyCode_)).Append("\n");
+		ret.Append("\t\tScale:  ").Append(ToString("%f", p.scale_)).Append("\n");
 	}
 	return ret;
 }
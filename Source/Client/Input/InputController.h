@@ -24,41 +24,59 @@
 #define INPUTCONTROLLER_H
 
 #include <Urho3D/Core/Object.h>
+#include "Input/InputFrame.h"
 #include "U3SClientAPI.h"
 
 namespace Urho3D
 {
-class Controls;
 class XMLElement;
-} // namespace Urho3D
+}
 
 class U3SCLIENTAPI_EXPORT InputController : public Urho3D::Object
 {
 	URHO3D_OBJECT(InputController, Urho3D::Object)
 
 public:
-	using BindingsMap = Urho3D::HashMap<unsigned, Urho3D::StringHash>;
-	using DefaultBindingsMap = Urho3D::HashMap<Urho3D::StringHash, unsigned>;
+	using BindingsMap = Urho3D::HashMap<Urho3D::StringHash, unsigned>; // Action -> Key
+	using DefaultBindingsMap = BindingsMap;
+
+	struct AxisBinding
+	{
+		unsigned keyCode_;
+		Urho3D::StringHash action_;
+		ActionAxis axis_;
+		float scale_; // Key down or raw axis value multiplier, negative to invert
+	};
+	using AxisBindingsVector = Urho3D::PODVector<AxisBinding>;
 
 	explicit InputController(Urho3D::Context* context);
 	virtual ~InputController() {}
 
 	virtual bool Enable() = 0;
 	virtual bool Disable() = 0;
-	virtual void ReadControls(Urho3D::Controls& controls) const = 0;
+	virtual void ReadControls(InputFrame& frame) const = 0;
 	virtual Urho3D::String GetKeyName(unsigned keyCode) const = 0;
 	virtual unsigned GetKeyCode(const Urho3D::String& keyName) const = 0;
 	virtual void StartBinding(Urho3D::StringHash action) = 0;
 	virtual void EndBinding() = 0;
 
-	bool LoadXML(const Urho3D::XMLElement& source);
-	void SaveXML(Urho3D::XMLElement& dst) const;
+	virtual bool LoadXML(const Urho3D::XMLElement& source);
+	virtual void SaveXML(Urho3D::XMLElement& dst) const;
 
 	void SetBinding(Urho3D::StringHash action, unsigned keyCode);
+	void RemoveBinding(Urho3D::StringHash action);
 	unsigned GetBindingKey(Urho3D::StringHash action) const;
 	const BindingsMap& GetBindings() const noexcept { return bindings_; }
 	void RemoveAllBindings();
 
+	// Several keys may drive one axis, e.g. W with scale 1 and S with scale -1
+	void SetAxisBinding(Urho3D::StringHash action, unsigned keyCode, float scale = 1.0f);
+	void RemoveAxisBinding(unsigned keyCode);
+	const AxisBindingsVector& GetAxisBindings() const noexcept { return axisBindings_; }
+
+	void SetDefaultAxisBinding(Urho3D::StringHash action, unsigned keyCode, float scale = 1.0f);
+	const AxisBindingsVector& GetDefaultAxisBindings() const noexcept { return defaultAxisBindings_; }
+
 	void SetDefaultBinding(Urho3D::StringHash action, unsigned keyCode) { defaultBindings_[action] = keyCode; }
 	void RemoveDefaultBinding(Urho3D::StringHash action) { defaultBindings_.Erase(action); }
 	unsigned GetDefaultBinding(Urho3D::StringHash action) const;
@@ -71,26 +89,44 @@ public:
 	Urho3D::String GetDebugString() const;
 
 protected:
-	using RemoteBindingsVector = Urho3D::PODVector<Urho3D::Pair<unsigned, unsigned>>;
+	// Maps key code into small dense range used by bindings table, M_MAX_UNSIGNED if key can not be bound
+	virtual unsigned GetKeyIndex(unsigned keyCode) const = 0;
 
 	void EnableSelf();
 	void DisableSelf();
 	void SendActionDown(unsigned keyCode);
 	void SendActionUp(unsigned keyCode);
 
-	const RemoteBindingsVector& GetRemoteBindings() const noexcept { return remoteBindings_; }
+	// Remote bindings are packed in parallel arrays: key of each flag is at the same index
+	const Urho3D::PODVector<unsigned>& GetRemoteKeys() const noexcept { return remoteKeys_; }
+	const Urho3D::PODVector<ActionFlag>& GetRemoteFlags() const noexcept { return remoteFlags_; }
 
 private:
-	BindingsMap bindings_;											// Key -> Action
-	RemoteBindingsVector remoteBindings_;							// Key -> Flag
-	Urho3D::HashMap<Urho3D::StringHash, unsigned> defaultBindings_; // Action -> Key
+	struct KeySlot
+	{
+		Urho3D::StringHash action_; // Zero if key is not bound
+		unsigned remote_;			// Index in remote arrays, M_MAX_UNSIGNED if action is local
+	};
+
+	Urho3D::StringHash GetKeyAction(unsigned keyCode) const;
+
+	Urho3D::PODVector<KeySlot> keys_;			// Key index -> Action
+	BindingsMap bindings_;						// Action -> Key
+	Urho3D::PODVector<unsigned> remoteKeys_;	// Remote binding -> Key
+	Urho3D::PODVector<ActionFlag> remoteFlags_; // Remote binding -> Flag
+	DefaultBindingsMap defaultBindings_;		// Action -> Key
+	AxisBindingsVector axisBindings_;
+	AxisBindingsVector defaultAxisBindings_;
 	float sensitivity_;
 };
 
 inline void InputController::RemoveAllBindings()
 {
+	keys_.Clear();
 	bindings_.Clear();
-	remoteBindings_.Clear();
+	remoteKeys_.Clear();
+	remoteFlags_.Clear();
+	axisBindings_.Clear();
 }
 
 #endif // INPUTCONTROLLER_H
@@ -0,0 +1,294 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Input/Input.h>
+#include <Urho3D/Input/InputConstants.h>
+#include <Urho3D/Input/InputEvents.h>
+#include <Urho3D/Resource/XMLElement.h>
+#include "InputEvents.h"
+#include "JoystickController.h"
+
+#define DEFAULT_DEADZONE 0.2f
+#define DEFAULT_RESPONSE_EXPONENT 2.0f
+#define LOOK_AXIS_X 2
+#define LOOK_AXIS_Y 3
+#define LOOK_RATE 720.0f
+#define BINDING_THRESHOLD 0.5f
+
+// Key codes: buttons, signed axes, negated axes and hat directions of all joysticks merged together
+static constexpr unsigned MAX_BUTTONS = 128;
+static constexpr unsigned MAX_AXES = 16;
+static constexpr unsigned MAX_HATS = 4;
+static constexpr unsigned BUTTON_BASE = 0x1000;
+static constexpr unsigned AXIS_BASE = 0x2000;
+static constexpr unsigned AXIS_NEGATIVE_BASE = 0x2100;
+static constexpr unsigned HAT_BASE = 0x3000;
+
+using namespace Urho3D;
+
+namespace
+{
+struct PadState
+{
+	float Get(unsigned keyCode) const
+	{
+		if (keyCode >= HAT_BASE)
+		{
+			const unsigned hat = (keyCode - HAT_BASE) / 16;
+			return hat < MAX_HATS && (hats_[hat] & ((keyCode - HAT_BASE) % 16)) ? 1.0f : 0.0f;
+		}
+		if (keyCode >= AXIS_NEGATIVE_BASE)
+			return keyCode - AXIS_NEGATIVE_BASE < MAX_AXES ? -axes_[keyCode - AXIS_NEGATIVE_BASE] : 0.0f;
+		if (keyCode >= AXIS_BASE)
+			return keyCode - AXIS_BASE < MAX_AXES ? axes_[keyCode - AXIS_BASE] : 0.0f;
+		if (keyCode >= BUTTON_BASE && keyCode - BUTTON_BASE < MAX_BUTTONS)
+		{
+			const unsigned button = keyCode - BUTTON_BASE;
+			return buttons_[button / 32] & (1u << (button % 32)) ? 1.0f : 0.0f;
+		}
+		return 0.0f;
+	}
+
+	float axes_[MAX_AXES];
+	unsigned buttons_[MAX_BUTTONS / 32];
+	int hats_[MAX_HATS];
+};
+
+const char* const HAT_DIRECTIONS[] = {"Up", "Right", "Down", "Left"};
+} // namespace
+
+JoystickController::JoystickController(Urho3D::Context* context)
+	: InputController(context)
+	, deadzone_(DEFAULT_DEADZONE)
+	, responseExponent_(DEFAULT_RESPONSE_EXPONENT)
+{
+}
+
+bool JoystickController::Enable()
+{
+	SubscribeToEvent(E_JOYSTICKBUTTONDOWN, URHO3D_HANDLER(JoystickController, OnButtonDown));
+	SubscribeToEvent(E_JOYSTICKBUTTONUP, URHO3D_HANDLER(JoystickController, OnButtonUp));
+	return true;
+}
+
+bool JoystickController::Disable()
+{
+	UnsubscribeFromAllEvents();
+	return true;
+}
+
+void JoystickController::ReadControls(InputFrame& frame) const
+{
+	const Input* input = GetSubsystem<Input>();
+	const unsigned joysticksCount = input->GetNumJoysticks();
+	if (!joysticksCount)
+		return;
+
+	PadState state{};
+	for (unsigned i = 0; i < joysticksCount; ++i)
+	{
+		const JoystickState* joystick = input->GetJoystickByIndex(i);
+		const unsigned axesCount = Min(joystick->GetNumAxes(), MAX_AXES);
+		for (unsigned axis = 0; axis < axesCount; ++axis)
+		{
+			const float position = joystick->GetAxisPosition(axis);
+			if (Abs(position) > Abs(state.axes_[axis]))
+				state.axes_[axis] = position;
+		}
+		const unsigned buttonsCount = Min(joystick->GetNumButtons(), MAX_BUTTONS);
+		for (unsigned button = 0; button < buttonsCount; ++button)
+			state.buttons_[button / 32] |= static_cast<unsigned>(joystick->GetButtonDown(button)) << (button % 32);
+		const unsigned hatsCount = Min(joystick->GetNumHats(), MAX_HATS);
+		for (unsigned hat = 0; hat < hatsCount; ++hat)
+			state.hats_[hat] |= joystick->GetHatPosition(hat);
+	}
+
+	// Sticks are axes pairs with radial deadzone, so diagonals are not clipped
+	for (unsigned axis = 0; axis < 4; axis += 2)
+	{
+		Vector2 stick(state.axes_[axis], state.axes_[axis + 1]);
+		const float length = stick.Length();
+		stick = length > deadzone_ ? stick * (ApplyResponse(length) / length) : Vector2::ZERO;
+		state.axes_[axis] = stick.x_;
+		state.axes_[axis + 1] = stick.y_;
+	}
+	for (unsigned axis = 4; axis < MAX_AXES; ++axis)
+	{
+		const float position = state.axes_[axis];
+		state.axes_[axis] = Abs(position) > deadzone_ ? Sign(position) * ApplyResponse(Abs(position)) : 0.0f;
+	}
+
+	const float lookStep = GetSensitivity() * LOOK_RATE * GetSubsystem<Time>()->GetTimeStep();
+	frame.yaw_ += state.axes_[LOOK_AXIS_X] * lookStep;
+	frame.pitch_ += state.axes_[LOOK_AXIS_Y] * lookStep;
+
+	const PODVector<unsigned>& keys = GetRemoteKeys();
+	const PODVector<ActionFlag>& flags = GetRemoteFlags();
+	for (unsigned i = 0; i < keys.Size(); ++i)
+		frame.actions_.Set(flags[i], state.Get(keys[i]) > BINDING_THRESHOLD);
+	for (const AxisBinding& p : GetAxisBindings())
+		frame.AddAxis(p.axis_, state.Get(p.keyCode_) * p.scale_);
+}
+
+float JoystickController::ApplyResponse(float magnitude) const
+{
+	const float scaled = Min((magnitude - deadzone_) / (1.0f - deadzone_), 1.0f);
+	return Pow(scaled, responseExponent_);
+}
+
+unsigned JoystickController::GetKeyIndex(unsigned keyCode) const
+{
+	if (keyCode >= HAT_BASE)
+		return keyCode - HAT_BASE < MAX_HATS * 16 ? MAX_BUTTONS + MAX_AXES * 2 + keyCode - HAT_BASE : M_MAX_UNSIGNED;
+	if (keyCode >= AXIS_NEGATIVE_BASE)
+		return keyCode - AXIS_NEGATIVE_BASE < MAX_AXES ? MAX_BUTTONS + MAX_AXES + keyCode - AXIS_NEGATIVE_BASE
+													   : M_MAX_UNSIGNED;
+	if (keyCode >= AXIS_BASE)
+		return keyCode - AXIS_BASE < MAX_AXES ? MAX_BUTTONS + keyCode - AXIS_BASE : M_MAX_UNSIGNED;
+	if (keyCode >= BUTTON_BASE && keyCode - BUTTON_BASE < MAX_BUTTONS)
+		return keyCode - BUTTON_BASE;
+	return M_MAX_UNSIGNED;
+}
+
+Urho3D::String JoystickController::GetKeyName(unsigned keyCode) const
+{
+	if (keyCode >= HAT_BASE)
+	{
+		const unsigned direction = (keyCode - HAT_BASE) % 16;
+		unsigned index = 0;
+		while (index < 3 && !(direction & (1u << index)))
+			++index;
+		return ToString("Hat%u%s", (keyCode - HAT_BASE) / 16, HAT_DIRECTIONS[index]);
+	}
+	else if (keyCode >= AXIS_NEGATIVE_BASE)
+		return ToString("Axis%u-", keyCode - AXIS_NEGATIVE_BASE);
+	else if (keyCode >= AXIS_BASE)
+		return ToString("Axis%u", keyCode - AXIS_BASE);
+	else if (keyCode >= BUTTON_BASE)
+		return ToString("Button%u", keyCode - BUTTON_BASE);
+	else
+		return String::EMPTY;
+}
+
+unsigned JoystickController::GetKeyCode(const Urho3D::String& keyName) const
+{
+	if (keyName.StartsWith("Hat"))
+	{
+		for (unsigned i = 0; i < 4; ++i)
+			if (keyName.EndsWith(HAT_DIRECTIONS[i]))
+			{
+				const String hat = keyName.Substring(3, keyName.Length() - 3 - String(HAT_DIRECTIONS[i]).Length());
+				return HAT_BASE + ToUInt(hat) * 16 + (1u << i);
+			}
+	}
+	else if (keyName.StartsWith("Axis") && keyName.EndsWith("-"))
+		return AXIS_NEGATIVE_BASE + ToUInt(keyName.Substring(4, keyName.Length() - 5));
+	else if (keyName.StartsWith("Axis"))
+		return AXIS_BASE + ToUInt(keyName.Substring(4));
+	else if (keyName.StartsWith("Button"))
+		return BUTTON_BASE + ToUInt(keyName.Substring(6));
+	return 0;
+}
+
+void JoystickController::StartBinding(Urho3D::StringHash action)
+{
+	Disable();
+	SubscribeToEvent(E_JOYSTICKBUTTONDOWN,
+					 [this, action](StringHash, VariantMap& eventData)
+					 {
+						 using namespace JoystickButtonDown;
+						 const unsigned button = static_cast<unsigned>(eventData[P_BUTTON].GetInt());
+						 using namespace InputBindingEnd;
+						 eventData[P_KEY] = BUTTON_BASE + button;
+						 eventData[P_ACTION] = action;
+						 SendEvent(E_INPUTBINDINGEND, eventData);
+						 EndBinding();
+					 });
+	SubscribeToEvent(E_JOYSTICKAXISMOVE,
+					 [this, action](StringHash, VariantMap& eventData)
+					 {
+						 using namespace JoystickAxisMove;
+						 const float position = eventData[P_POSITION].GetFloat();
+						 if (Abs(position) < BINDING_THRESHOLD)
+							 return;
+						 const unsigned axis = static_cast<unsigned>(eventData[P_AXIS].GetInt());
+						 using namespace InputBindingEnd;
+						 eventData[P_KEY] = (position > 0.0f ? AXIS_BASE : AXIS_NEGATIVE_BASE) + axis;
+						 eventData[P_ACTION] = action;
+						 SendEvent(E_INPUTBINDINGEND, eventData);
+						 EndBinding();
+					 });
+	SubscribeToEvent(E_JOYSTICKHATMOVE,
+					 [this, action](StringHash, VariantMap& eventData)
+					 {
+						 using namespace JoystickHatMove;
+						 const int position = eventData[P_POSITION].GetInt();
+						 if (position == HAT_CENTER)
+							 return;
+						 const unsigned hat = static_cast<unsigned>(eventData[P_HAT].GetInt());
+						 using namespace InputBindingEnd;
+						 eventData[P_KEY] = HAT_BASE + hat * 16 + static_cast<unsigned>(position & -position);
+						 eventData[P_ACTION] = action;
+						 SendEvent(E_INPUTBINDINGEND, eventData);
+						 EndBinding();
+					 });
+}
+
+void JoystickController::EndBinding()
+{
+	UnsubscribeFromAllEvents();
+	Enable();
+}
+
+bool JoystickController::LoadXML(const Urho3D::XMLElement& source)
+{
+	if (!InputController::LoadXML(source))
+		return false;
+	const XMLElement deadzone = source.GetChild("deadzone");
+	if (!deadzone.IsNull())
+		SetDeadzone(Clamp(deadzone.GetFloat("value"), 0.0f, 0.95f));
+	const XMLElement response = source.GetChild("response");
+	if (!response.IsNull())
+		SetResponseExponent(Max(response.GetFloat("exponent"), M_EPSILON));
+	return true;
+}
+
+void JoystickController::SaveXML(Urho3D::XMLElement& dst) const
+{
+	InputController::SaveXML(dst);
+	dst.CreateChild("deadzone").SetFloat("value", GetDeadzone());
+	dst.CreateChild("response").SetFloat("exponent", GetResponseExponent());
+}
+
+void JoystickController::OnButtonDown(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace JoystickButtonDown;
+	SendActionDown(BUTTON_BASE + static_cast<unsigned>(eventData[P_BUTTON].GetInt()));
+}
+
+void JoystickController::OnButtonUp(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace JoystickButtonUp;
+	SendActionUp(BUTTON_BASE + static_cast<unsigned>(eventData[P_BUTTON].GetInt()));
+}
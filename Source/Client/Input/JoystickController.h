@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef JOYSTICKCONTROLLER_H
+#define JOYSTICKCONTROLLER_H
+
+#include "InputController.h"
+#include "U3SClientAPI.h"
+
+class U3SCLIENTAPI_EXPORT JoystickController : public InputController
+{
+	URHO3D_OBJECT(JoystickController, InputController)
+
+public:
+	explicit JoystickController(Urho3D::Context* context);
+
+	bool Enable() override;
+	bool Disable() override;
+	void ReadControls(InputFrame& frame) const override;
+	Urho3D::String GetKeyName(unsigned keyCode) const override;
+	unsigned GetKeyCode(const Urho3D::String& keyName) const override;
+	void StartBinding(Urho3D::StringHash action) override;
+	void EndBinding() override;
+
+	bool LoadXML(const Urho3D::XMLElement& source) override;
+	void SaveXML(Urho3D::XMLElement& dst) const override;
+
+	void SetDeadzone(float deadzone) noexcept { deadzone_ = deadzone; }
+	void SetResponseExponent(float exponent) noexcept { responseExponent_ = exponent; }
+
+	float GetDeadzone() const noexcept { return deadzone_; }
+	float GetResponseExponent() const noexcept { return responseExponent_; }
+
+protected:
+	unsigned GetKeyIndex(unsigned keyCode) const override;
+
+private:
+	void OnButtonDown(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+	void OnButtonUp(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+
+	float ApplyResponse(float magnitude) const;
+
+	float deadzone_;		 // Radial for sticks, linear for other axes
+	float responseExponent_; // 1 is linear, higher values give finer control near center
+};
+
+#endif // JOYSTICKCONTROLLER_H
@@ -20,7 +20,6 @@
 // THE SOFTWARE.
 //
 
-#include <Urho3D/Input/Controls.h>
 #include <Urho3D/Input/Input.h>
 #include <Urho3D/Input/InputConstants.h>
 #include <Urho3D/Input/InputEvents.h>
@@ -32,6 +31,17 @@
 #define MIDDLE_BUTTON_NAME "MMB"
 #define AUX_BUTTON_1_NAME "X1"
 #define AUX_BUTTON_2_NAME "X2"
+#define MOUSE_AXIS_X_NAME "MouseX"
+#define MOUSE_AXIS_Y_NAME "MouseY"
+
+// Outside of SDL key codes range
+static constexpr unsigned MOUSE_AXIS_X = 0x80000001u;
+static constexpr unsigned MOUSE_AXIS_Y = 0x80000002u;
+
+// SDL key codes are either characters or scan codes marked with bit 30
+static constexpr unsigned CHAR_KEYS = 128;
+static constexpr unsigned SCANCODE_MASK = 1u << 30;
+static constexpr unsigned MAX_SCANCODES = 512;
 
 using namespace Urho3D;
 
@@ -50,13 +60,28 @@ bool KeyboardController::Disable()
 	return true;
 }
 
-void KeyboardController::ReadControls(Urho3D::Controls& controls) const
+void KeyboardController::ReadControls(InputFrame& frame) const
 {
 	const Input* input = GetSubsystem<Input>();
-	controls.pitch_ += static_cast<float>(input->GetMouseMoveY()) * GetSensitivity();
-	controls.yaw_ += static_cast<float>(input->GetMouseMoveX()) * GetSensitivity();
-	for (const auto& p : GetRemoteBindings())
-		controls.buttons_ |= p.second_ * static_cast<unsigned>(input->GetKeyDown(static_cast<Key>(p.first_)));
+	frame.pitch_ += static_cast<float>(input->GetMouseMoveY()) * GetSensitivity();
+	frame.yaw_ += static_cast<float>(input->GetMouseMoveX()) * GetSensitivity();
+	const PODVector<unsigned>& keys = GetRemoteKeys();
+	const PODVector<ActionFlag>& flags = GetRemoteFlags();
+	for (unsigned i = 0; i < keys.Size(); ++i)
+		frame.actions_.Set(flags[i], input->GetKeyDown(static_cast<Key>(keys[i])));
+
+	const IntVector2 mouseMove = input->GetMouseMove();
+	float value;
+	for (const AxisBinding& p : GetAxisBindings())
+	{
+		if (p.keyCode_ == MOUSE_AXIS_X)
+			value = static_cast<float>(mouseMove.x_) * GetSensitivity();
+		else if (p.keyCode_ == MOUSE_AXIS_Y)
+			value = static_cast<float>(mouseMove.y_) * GetSensitivity();
+		else
+			value = static_cast<float>(input->GetKeyDown(static_cast<Key>(p.keyCode_)));
+		frame.AddAxis(p.axis_, value * p.scale_);
+	}
 }
 
 Urho3D::String KeyboardController::GetKeyName(unsigned keyCode) const
@@ -73,6 +98,10 @@ Urho3D::String KeyboardController::GetKeyName(unsigned keyCode) const
 		return AUX_BUTTON_1_NAME;
 	case MouseButton::MOUSEB_X2:
 		return AUX_BUTTON_2_NAME;
+	case MOUSE_AXIS_X:
+		return MOUSE_AXIS_X_NAME;
+	case MOUSE_AXIS_Y:
+		return MOUSE_AXIS_Y_NAME;
 	default:
 		return GetSubsystem<Input>()->GetKeyName(static_cast<Key>(keyCode));
 	}
@@ -90,10 +119,24 @@ unsigned KeyboardController::GetKeyCode(const Urho3D::String& keyName) const
 		return MouseButton::MOUSEB_X1;
 	else if (keyName == AUX_BUTTON_2_NAME)
 		return MouseButton::MOUSEB_X2;
+	else if (keyName == MOUSE_AXIS_X_NAME)
+		return MOUSE_AXIS_X;
+	else if (keyName == MOUSE_AXIS_Y_NAME)
+		return MOUSE_AXIS_Y;
 	else
 		return static_cast<unsigned>(GetSubsystem<Input>()->GetKeyFromName(keyName));
 }
 
+unsigned KeyboardController::GetKeyIndex(unsigned keyCode) const
+{
+	if (keyCode < CHAR_KEYS)
+		return keyCode; // Mouse buttons are here too
+	const unsigned scancode = keyCode & ~SCANCODE_MASK;
+	if (keyCode & SCANCODE_MASK && scancode < MAX_SCANCODES)
+		return CHAR_KEYS + scancode;
+	return M_MAX_UNSIGNED;
+}
+
 void KeyboardController::StartBinding(Urho3D::StringHash action)
 {
 	Disable();
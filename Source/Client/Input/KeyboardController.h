@@ -35,12 +35,15 @@ public:
 
 	bool Enable() override;
 	bool Disable() override;
-	void ReadControls(Urho3D::Controls& controls) const override;
+	void ReadControls(InputFrame& frame) const override;
 	Urho3D::String GetKeyName(unsigned keyCode) const override;
 	unsigned GetKeyCode(const Urho3D::String& keyName) const override;
 	void StartBinding(Urho3D::StringHash action) override;
 	void EndBinding() override;
 
+protected:
+	unsigned GetKeyIndex(unsigned keyCode) const override;
+
 private:
 	void OnKeyDown(Urho3D::StringHash, Urho3D::VariantMap& eventData);
 	void OnKeyUp(Urho3D::StringHash, Urho3D::VariantMap& eventData);
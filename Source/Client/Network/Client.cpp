@@ -21,22 +21,35 @@
 //
 
 #include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/VectorBuffer.h>
 #include <Urho3D/Network/Network.h>
 #include <Urho3D/Network/NetworkEvents.h>
 #include <Urho3D/Physics/PhysicsEvents.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Scene/LogicComponent.h>
 #include <Urho3D/Scene/SceneEvents.h>
 #include "Client.h"
 #include "Core/ShellEvents.h"
 #include "Input/ControllersRegistry.h"
+#include "Input/InputReceiver.h"
 #include "Network/NetworkEvents.h"
 #include "Network/ServerDefs.h"
 
+#define DEFAULT_INPUT_REDUNDANCY 3
+
 using namespace Urho3D;
 
 Client::Client(Urho3D::Context* context)
 	: Object(context)
 	, scene_(context)
+	, input_{}
+	, recording_(context)
 	, playerName_("Player")
+	, sequence_(0)
+	, ackSequence_(0)
+	, predictionError_(0.0f)
+	, inputRedundancy_(DEFAULT_INPUT_REDUNDANCY)
+	, prediction_(true)
 {
 	URHO3D_LOGTRACE("Client::Client");
 	SubscribeToEvent(E_ASYNCLOADFINISHED, URHO3D_HANDLER(Client, OnSceneLoaded));
@@ -74,14 +87,27 @@ void Client::Disconnect()
 		network->Disconnect();
 		SendEvent(E_REMOTECLIENTSTOPPED);
 	}
+	UnsubscribeFromEvent(E_PHYSICSPRESTEP);
+	UnsubscribeFromEvent(E_PHYSICSPOSTSTEP);
+	physics_.Reset();
+	node_.Reset();
+	receiver_.Reset();
+	recording_.StopRecording();
+}
+
+bool Client::IsConnected() const
+{
+	const Connection* connection = GetSubsystem<Network>()->GetServerConnection();
+	return connection && connection->IsConnected();
 }
 
 static Urho3D::Connection* conn;
 
 void Client::OnServerConnected(Urho3D::StringHash, Urho3D::VariantMap&)
 {
-	SubscribeToEvent(E_SCENEUPDATE, URHO3D_HANDLER(Client, OnSceneUpdated));
-	SubscribeToEvent(E_PHYSICSPRESTEP, URHO3D_HANDLER(Client, OnPhysicsPreStep));
+	// Server scene of local server is updated and stepped in the same process, so only own scene is handled
+	SubscribeToEvent(&scene_, E_SCENEUPDATE, URHO3D_HANDLER(Client, OnSceneUpdated));
+	SubscribeToEvent(E_SERVERSIDESPAWNED, URHO3D_HANDLER(Client, OnServerSideSpawned));
 }
 
 void Client::OnConnectFailed(Urho3D::StringHash, Urho3D::VariantMap&) { URHO3D_LOGTRACE("Client::OnConnectFailed"); }
@@ -90,11 +116,116 @@ void Client::OnSceneLoaded(Urho3D::StringHash, Urho3D::VariantMap&) { URHO3D_LOG
 
 void Client::OnSceneUpdated(Urho3D::StringHash, Urho3D::VariantMap&)
 {
-	GetSubsystem<ControllersRegistry>()->ReadControls(controls_);
+	// Physics world may arrive with replicated components, so its steps are subscribed once it exists
+	if (!physics_)
+	{
+		physics_ = scene_.GetComponent<PhysicsWorld>();
+		if (physics_)
+		{
+			SubscribeToEvent(physics_, E_PHYSICSPRESTEP, URHO3D_HANDLER(Client, OnPhysicsPreStep));
+			SubscribeToEvent(physics_, E_PHYSICSPOSTSTEP, URHO3D_HANDLER(Client, OnPhysicsPostStep));
+		}
+	}
+	GetSubsystem<ControllersRegistry>()->ReadControls(input_);
+	Reconcile();
 }
 
+// Player components are created on spawn and subscribe after this, so sampled input is predicted in this step
 void Client::OnPhysicsPreStep(Urho3D::StringHash, Urho3D::VariantMap&)
 {
+	++sequence_;
+	input_.sequence_ = sequence_;
+	history_[sequence_ % INPUT_HISTORY] = input_;
+	recording_.Record(input_);
+	input_.ToControls(controls_);
+
+	// Resend preceding frames, so single lost packet does not lose presses
+	const unsigned redundancy = Min(inputRedundancy_, sequence_ - 1);
+	if (redundancy)
+	{
+		resent_.Clear();
+		for (unsigned sequence = sequence_ - redundancy; sequence != sequence_; ++sequence)
+			resent_.Push(history_[sequence % INPUT_HISTORY]);
+		VectorBuffer buffer;
+		InputFrame::WriteHistory(buffer, resent_, input_);
+		controls_.extraData_[CL_INPUT_HISTORY] = buffer.GetBuffer();
+	}
+	else
+		controls_.extraData_.Erase(CL_INPUT_HISTORY);
 	GetSubsystem<Network>()->GetServerConnection()->SetControls(controls_);
-	controls_.buttons_ = 0;
+	if (receiver_ && node_)
+		receiver_->SetInput(input_);
+	input_.actions_.Clear();
+}
+
+// Fixed updates of the step are done regardless of subscription order
+void Client::OnPhysicsPostStep(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	if (node_)
+		predictedPosition_ = node_->GetPosition();
+}
+
+void Client::OnServerSideSpawned(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace ServerSideSpawned;
+	const Connection* connection = static_cast<Connection*>(eventData[P_CONNECTION].GetPtr());
+	if (connection->IsClient() || !prediction_)
+		return;
+
+	Node* node = scene_.GetNode(eventData[P_NODE].GetUInt());
+	InputReceiver* receiver = node ? node->GetComponent<InputReceiver>() : nullptr;
+	if (!receiver || !physics_)
+	{
+		URHO3D_LOGWARNING("Client prediction is disabled: player node is not replicated or scene has no physics.");
+		return;
+	}
+	receiver->SetPredicted(true);
+	node_ = node;
+	receiver_ = receiver;
+	ackSequence_ = sequence_;
+	predictedPosition_ = node->GetPosition();
+}
+
+void Client::Reconcile()
+{
+	if (!receiver_ || !node_)
+		return;
+
+	const unsigned ackSequence = receiver_->GetAckSequence();
+	if (static_cast<int>(ackSequence - ackSequence_) <= 0)
+		return;
+
+	// Rewind to authoritative state and replay inputs applied locally but not yet by server. Rotation is only
+	// replayed for movement in local space, node keeps the one of current input.
+	ackSequence_ = ackSequence;
+	const Quaternion rotation = node_->GetRotation();
+	node_->SetPosition(receiver_->GetAckPosition());
+	node_->SetRotation(receiver_->GetAckRotation());
+	if (sequence_ - ackSequence_ < INPUT_HISTORY)
+	{
+		const float timeStep = 1.0f / static_cast<float>(physics_->GetFps());
+		receiver_->SetInput(history_[ackSequence_ % INPUT_HISTORY]);
+		for (unsigned sequence = ackSequence_ + 1; sequence != sequence_; ++sequence)
+			ReplayInput(history_[sequence % INPUT_HISTORY], timeStep);
+		receiver_->SetInput(history_[sequence_ % INPUT_HISTORY]);
+	}
+	node_->SetRotation(rotation);
+	predictionError_ = (node_->GetPosition() - predictedPosition_).Length();
+	predictedPosition_ = node_->GetPosition();
+}
+
+void Client::ReplayInput(const InputFrame& frame, float timeStep)
+{
+	receiver_->SetInput(frame);
+	// Controllers derive rotation from input in variable update, so it is replayed through them as well
+	for (Component* component : node_->GetComponents())
+	{
+		if (!component->IsInstanceOf<LogicComponent>() || !component->IsEnabledEffective())
+			continue;
+		LogicComponent* logic = static_cast<LogicComponent*>(component);
+		if (logic->GetUpdateEventMask() & USE_UPDATE)
+			logic->Update(timeStep);
+		if (logic->GetUpdateEventMask() & USE_FIXEDUPDATE)
+			logic->FixedUpdate(timeStep);
+	}
 }
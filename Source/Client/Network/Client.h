@@ -26,8 +26,17 @@
 #include <Urho3D/Core/Object.h>
 #include <Urho3D/Input/Controls.h>
 #include <Urho3D/Scene/Scene.h>
+#include "Input/InputFrame.h"
+#include "Input/InputRecording.h"
 #include "U3SClientAPI.h"
 
+namespace Urho3D
+{
+class PhysicsWorld;
+} // namespace Urho3D
+
+class InputReceiver;
+
 class U3SCLIENTAPI_EXPORT Client : public Urho3D::Object
 {
 	URHO3D_OBJECT(Client, Urho3D::Object)
@@ -39,9 +48,23 @@ public:
 	bool Connect(unsigned short port, const Urho3D::String& address = "localhost");
 	void Disconnect();
 
+	// Sent input frames are written to recordings path of user profile
+	bool StartRecording(const Urho3D::String& name) { return recording_.StartRecording(name); }
+	void StopRecording() { recording_.StopRecording(); }
+
 	void SetPlayerName(const Urho3D::String& playerName) { playerName_ = playerName; }
+	void SetPrediction(bool prediction) { prediction_ = prediction; }
+	void SetInputRedundancy(unsigned redundancy) { inputRedundancy_ = Urho3D::Min(redundancy, INPUT_HISTORY - 1); }
 
 	const Urho3D::String& GetPlayerName() const { return playerName_; }
+	unsigned GetPendingInputs() const { return sequence_ - ackSequence_; }
+	unsigned GetInputRedundancy() const { return inputRedundancy_; }
+	float GetPredictionError() const { return predictionError_; }
+	bool IsConnected() const;
+	bool IsPrediction() const { return prediction_; }
+	bool IsRecording() const { return recording_.IsRecording(); }
+
+	static constexpr unsigned INPUT_HISTORY = InputFrame::MAX_HISTORY;
 
 private:
 	void OnServerConnected(Urho3D::StringHash, Urho3D::VariantMap&);
@@ -49,10 +72,28 @@ private:
 	void OnSceneLoaded(Urho3D::StringHash, Urho3D::VariantMap&);
 	void OnSceneUpdated(Urho3D::StringHash, Urho3D::VariantMap&);
 	void OnPhysicsPreStep(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnPhysicsPostStep(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnServerSideSpawned(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+
+	void Reconcile();
+	void ReplayInput(const InputFrame& frame, float timeStep);
 
-	Urho3D::Controls controls_;
+	InputFrame input_;						// Accumulated since last physics step
+	InputFrame history_[INPUT_HISTORY];		// Sent frames by sequence
+	Urho3D::PODVector<InputFrame> resent_; // Preceding frames for current packet
+	Urho3D::Controls controls_;				// Network packet
+	InputRecording recording_;
 	Urho3D::Scene scene_;
 	Urho3D::String playerName_;
+	Urho3D::WeakPtr<Urho3D::PhysicsWorld> physics_; // Of own scene
+	Urho3D::WeakPtr<Urho3D::Node> node_;
+	Urho3D::WeakPtr<InputReceiver> receiver_;
+	Urho3D::Vector3 predictedPosition_; // After last local physics step
+	unsigned sequence_;
+	unsigned ackSequence_;
+	float predictionError_; // Correction of last acknowledged input
+	unsigned inputRedundancy_; // Preceding frames resent in every packet
+	bool prediction_;
 };
 
 #endif // CLIENT_H
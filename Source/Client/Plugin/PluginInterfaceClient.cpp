@@ -40,6 +40,8 @@ void PluginInterfaceClient::OnServerSideSpawned(Urho3D::StringHash, Urho3D::Vari
 {
 	using namespace ServerSideSpawned;
 	const Connection* connection = static_cast<Connection*>(eventData[P_CONNECTION].GetPtr());
+	if (connection->IsClient())
+		return; // Server side notification in listen server
 	const unsigned nodeId = eventData[P_NODE].GetInt();
 	Scene* scene = connection->GetScene();
 	Spawn(scene, nodeId);
@@ -58,6 +58,28 @@ template <typename T> void RegisterMembers_FrontState(asIScriptEngine* engine, c
 								 AS_CALL_THISCALL);
 }
 
+template <typename T> void RegisterMembers_ServerState(asIScriptEngine* engine, const char* className)
+{
+	RegisterMembers_FrontState<T>(engine, className);
+	engine->RegisterObjectMethod(className, "bool RestartScene()", AS_METHOD(T, RestartScene), AS_CALL_THISCALL);
+	engine->RegisterObjectMethod(className, "bool SaveGame(const String&in)", AS_METHOD(T, SaveGame), AS_CALL_THISCALL);
+	engine->RegisterObjectMethod(className,
+								 "bool StartReplay(uint, const String&in)",
+								 AS_METHOD(T, StartReplay),
+								 AS_CALL_THISCALL);
+	engine->RegisterObjectMethod(className, "void StopReplay(uint)", AS_METHOD(T, StopReplay), AS_CALL_THISCALL);
+}
+
+// States owning local client
+template <typename T> void RegisterMembers_Recording(asIScriptEngine* engine, const char* className)
+{
+	engine->RegisterObjectMethod(className,
+								 "bool StartRecording(const String&in)",
+								 AS_METHOD(T, StartRecording),
+								 AS_CALL_THISCALL);
+	engine->RegisterObjectMethod(className, "void StopRecording()", AS_METHOD(T, StopRecording), AS_CALL_THISCALL);
+}
+
 extern void RegisterDialogAPI(asIScriptEngine* engine);
 
 static ClientState* Create_ClientState(const String& address, unsigned short port)
@@ -145,10 +167,12 @@ void RegisterFrontStateAPI(asIScriptEngine* engine)
 	RegisterSubclass<RefCounted, RemoteServerState>(engine, "RefCounted", "RemoteServerState");
 
 	RegisterMembers_FrontState<ClientState>(engine, "ClientState");
+	RegisterMembers_Recording<ClientState>(engine, "ClientState");
 	RegisterMembers_FrontState<FrontState>(engine, "FrontState");
 	RegisterMembers_FrontState<GameState>(engine, "GameState");
-	RegisterMembers_FrontState<LocalServerState>(engine, "LocalServerState");
+	RegisterMembers_ServerState<LocalServerState>(engine, "LocalServerState");
+	RegisterMembers_Recording<LocalServerState>(engine, "LocalServerState");
 	RegisterMembers_FrontState<MainMenuState>(engine, "MainMenuState");
-	RegisterMembers_FrontState<RemoteServerState>(engine, "RemoteServerState");
-	RegisterMembers_FrontState<ServerState>(engine, "ServerState");
+	RegisterMembers_ServerState<RemoteServerState>(engine, "RemoteServerState");
+	RegisterMembers_ServerState<ServerState>(engine, "ServerState");
 }
@@ -53,7 +53,7 @@ ItemsListWindow::ItemsListWindow(Urho3D::Context* context)
 	SubscribeToEvent(root_->GetChild("Server", true), E_TOGGLED, URHO3D_HANDLER(ItemsListWindow, OnServerToggled));
 }
 
-void ItemsListWindow::AddItem(const Urho3D::String& itemName, const Urho3D::StringVector& itemRow)
+Urho3D::UIElement* ItemsListWindow::AddItem(const Urho3D::String& itemName, const Urho3D::StringVector& itemRow)
 {
 	SharedPtr<UISelectable> item = MakeShared<UISelectable>(context_);
 	itemList_->AddItem(item);
@@ -68,6 +68,7 @@ void ItemsListWindow::AddItem(const Urho3D::String& itemName, const Urho3D::Stri
 		text->SetText(ceil);
 		text->SetStyleAuto();
 	}
+	return item;
 }
 
 void ItemsListWindow::RemoveAllItems() { itemList_->RemoveAllItems(); }
@@ -39,7 +39,7 @@ class U3SCLIENTAPI_EXPORT ItemsListWindow : public Dialog
 public:
 	explicit ItemsListWindow(Urho3D::Context* context);
 
-	void AddItem(const Urho3D::String& itemName, const Urho3D::StringVector& itemRow);
+	Urho3D::UIElement* AddItem(const Urho3D::String& itemName, const Urho3D::StringVector& itemRow);
 	void RemoveAllItems();
 
 	void SetTitle(const Urho3D::String& title);
@@ -20,7 +20,15 @@
 // THE SOFTWARE.
 //
 
+#include <Urho3D/Graphics/Texture2D.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/UI/BorderImage.h>
 #include "LoadGameDialog.h"
+#include "Network/SaveGame.h"
+
+#define THUMBNAIL_WIDTH 80
+#define THUMBNAIL_HEIGHT 45
 
 using namespace Urho3D;
 
@@ -28,5 +36,32 @@ LoadGameDialog::LoadGameDialog(Urho3D::Context* context)
 	: HostItemsListWindow(context)
 {
 	SetTitle("LoadGame");
-	SetCaptions({"Name", "Date"});
+	SetCaptions({"Preview", "Name", "Date"});
+
+	StringVector row(2);
+	for (const SaveGame::Info& save : GetSubsystem<SaveGame>()->GetSaves())
+	{
+		row[0] = save.name_;
+		row[1] = save.date_;
+		AddThumbnail(AddItem(save.filename_, row), save.thumbnail_);
+	}
+}
+
+void LoadGameDialog::AddThumbnail(Urho3D::UIElement* item, const Urho3D::String& filename)
+{
+	// First column, before name and date texts added by AddItem()
+	SharedPtr<BorderImage> thumbnail = MakeShared<BorderImage>(context_);
+	item->InsertChild(0, thumbnail);
+	thumbnail->SetFixedSize(THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT);
+	if (filename.Empty() || !GetSubsystem<FileSystem>()->FileExists(filename))
+		return;
+
+	Image image(context_);
+	if (image.LoadFile(filename))
+	{
+		SharedPtr<Texture2D> texture = MakeShared<Texture2D>(context_);
+		texture->SetData(&image);
+		thumbnail->SetTexture(texture);
+		thumbnail->SetFullImageRect();
+	}
 }
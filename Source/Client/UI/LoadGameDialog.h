@@ -31,6 +31,9 @@ class LoadGameDialog : public HostItemsListWindow
 
 public:
 	explicit LoadGameDialog(Urho3D::Context* context);
+
+private:
+	void AddThumbnail(Urho3D::UIElement* item, const Urho3D::String& filename);
 };
 
 #endif // LOADGAMEDIALOG_H
@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/UI/Text.h>
+#include "LoadingDialog.h"
+#include "Network/NetworkEvents.h"
+
+using namespace Urho3D;
+
+LoadingDialog::LoadingDialog(Urho3D::Context* context)
+	: Dialog(context)
+{
+	LoadLayout("UI/LoadingDialog.xml");
+	status_ = root_->GetChildStaticCast<Text>("Status", true);
+	bar_ = root_->GetChild("Bar", true);
+	fill_ = bar_->GetChild("Fill", true);
+	fill_->SetWidth(0);
+
+	SubscribeToEvent(E_SCENELOADPROGRESS, URHO3D_HANDLER(LoadingDialog, OnSceneLoadProgress));
+}
+
+void LoadingDialog::OnSceneLoadProgress(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace SceneLoadProgress;
+	const float progress = Clamp(eventData[P_PROGRESS].GetFloat(), 0.0f, 1.0f);
+	fill_->SetWidth(RoundToInt(static_cast<float>(bar_->GetWidth()) * progress));
+
+	const int loadedResources = eventData[P_LOADEDRESOURCES].GetInt();
+	const int totalResources = eventData[P_TOTALRESOURCES].GetInt();
+	const float megabytes = static_cast<float>(eventData[P_LOADEDBYTES].GetUInt64()) / (1024.0f * 1024.0f);
+	if (loadedResources < totalResources)
+		status_->SetText(ToString("Resources %d/%d (%.1f MB)", loadedResources, totalResources, megabytes));
+	else
+		status_->SetText(ToString("Nodes %d/%d (%.1f MB)",
+								  eventData[P_LOADEDNODES].GetInt(),
+								  eventData[P_TOTALNODES].GetInt(),
+								  megabytes));
+}
@@ -23,6 +23,7 @@
 #include <Urho3D/UI/UIEvents.h>
 #include "FrontState/FrontStateMachine.h"
 #include "FrontState/MainMenuState.h"
+#include "FrontState/ServerState.h"
 #include "PauseDialog.h"
 
 using namespace Urho3D;
@@ -43,8 +44,13 @@ PauseDialog::PauseDialog(Urho3D::Context* context)
 
 void PauseDialog::OnResume(Urho3D::StringHash, Urho3D::VariantMap&) { Close(); }
 void PauseDialog::OnLoadGame(Urho3D::StringHash, Urho3D::VariantMap&) { GetParent()->CreateDialog("LoadGameDialog"); }
+// TODO: SaveGameDialog to name saves, until then single quick save slot is used
 void PauseDialog::OnSaveGame(Urho3D::StringHash, Urho3D::VariantMap&)
-{ /*TODO: SaveGameDialog*/
+{
+	FrontState* state = GetParent();
+	if (state->IsInstanceOf<ServerState>())
+		static_cast<ServerState*>(state)->SaveGame("Quicksave");
+	Close();
 }
 void PauseDialog::OnSettings(Urho3D::StringHash, Urho3D::VariantMap&) { GetParent()->CreateDialog("SettingsDialog"); }
 
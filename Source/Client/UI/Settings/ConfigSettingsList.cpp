@@ -29,6 +29,7 @@
 #include <Urho3D/UI/Text.h>
 #include <Urho3D/UI/UIEvents.h>
 #include "Config/Config.h"
+#include "Config/ConfigDefs.h"
 #include "ConfigSettingsList.h"
 
 #define CB_ITEM_VALUE "Item"
@@ -47,12 +48,15 @@ ConfigSettingsList::ConfigSettingsList(Urho3D::StringHash settingsTab,
 	Variant value;
 	for (const String& parameter : parameters)
 	{
+		// Dedicated server only, listen server never throttles client frame rate
+		if (parameter == CP_TICK_RATE)
+			continue;
 		item = CreateCaption(parameter);
 		value = config->ReadValue(parameter);
 		if (config->IsEnum(parameter))
 		{
 			const bool localized = config->IsLocalized(parameter);
-			const EnumVector items = config->ConstructEnum(parameter);
+			const EnumVector& items = config->ConstructEnum(parameter);
 			CreateParameterEnum(parameter, items, value, item, localized);
 		}
 		else
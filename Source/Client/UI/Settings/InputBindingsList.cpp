@@ -164,11 +164,11 @@ void InputBindingsList::LoadControllerSettings(const InputController* controller
 	Text* caption;
 	for (const auto& p : bindings)
 	{
-		actionIt = actions_.Find(p.second_);
+		actionIt = actions_.Find(p.first_);
 		if (actionIt != actions_.End())
 		{
 			caption = actionIt->second_->GetChild(1)->GetChildStaticCast<Text>(0);
-			caption->SetText(controller->GetKeyName(p.first_));
+			caption->SetText(controller->GetKeyName(p.second_));
 		}
 	}
 }
@@ -60,7 +60,10 @@ SettingsDialog::SettingsDialog(Urho3D::Context* context)
 	tabButton = CreateSettingsTab("Controls");
 	SubscribeToEvent(tabButton, E_PRESSED, [this](StringHash, VariantMap&) { ShowControlsTab(); });
 
-	ShowSettingsTab(tabs[0]);
+	if (tabs.Empty())
+		ShowControlsTab();
+	else
+		ShowSettingsTab(tabs[0]);
 }
 
 void SettingsDialog::ShowSettingsTab(Urho3D::StringHash settingsTab)
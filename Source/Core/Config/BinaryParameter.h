@@ -81,6 +81,12 @@ public:
 	{
 	}
 
+	// Value set but not applied yet is the one further writes are compared against
+	Urho3D::Variant Read() override
+	{
+		const Urho3D::Variant* pending = storage_->GetPending(name_);
+		return pending ? *pending : BinaryParameter::Read();
+	}
 	void Write(const Urho3D::Variant& value) override { storage_->Set(name_, value); }
 
 private:
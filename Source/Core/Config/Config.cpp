@@ -20,19 +20,51 @@
 // THE SOFTWARE.
 //
 
+#include <Urho3D/Container/Sort.h>
+#include <Urho3D/Core/CoreEvents.h>
 #include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/Engine/EngineDefs.h>
 #include <Urho3D/IO/Deserializer.h>
 #include <Urho3D/IO/Log.h>
 #include <Urho3D/IO/Serializer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Math/MathDefs.h>
 #include <Urho3D/Resource/JSONValue.h>
 #include <Urho3D/Resource/XMLElement.h>
 #include "BinaryParameter.h"
 #include "Config.h"
 #include "ConfigDefs.h"
+#include "ConfigEvents.h"
+
+#define BINARY_HEADER_SIZE 16
+#define BINARY_ID "U3CF"
+#define BINARY_RECORD_SIZE 16
+#define BINARY_VERSION 1
 
 using namespace Urho3D;
 
+static const EnumVector emptyEnum;
+
+struct Config::EnumJob
+{
+	Vector<SharedPtr<EnumConstructor>> constructors_;
+	PODVector<unsigned> versions_; // Of constructors when job was queued
+	Vector<EnumVector> results_;
+};
+
+Config::Config(Urho3D::Context* context)
+	: Object(context)
+{
+}
+
+Config::~Config()
+{
+	WorkQueue* queue = GetSubsystem<WorkQueue>();
+	if (enumJob_ && queue)
+		queue->Complete(0);
+}
+
 void Config::Initialize(Urho3D::VariantMap& engineParameters,
 						Urho3D::VariantMap& shellParameters,
 						const Urho3D::XMLElement& source)
@@ -47,12 +79,53 @@ void Config::Initialize(Urho3D::VariantMap& engineParameters,
 			URHO3D_LOGWARNING("Failed to setup config parameter: name is empty.");
 		else if (value.IsEmpty())
 			URHO3D_LOGWARNINGF("Failed to setup config parameter %s: value is empty.", name.CString());
-		else if (!parameters_.Contains(name))
+		else if (!index_.Contains(name))
 			URHO3D_LOGWARNINGF("Failed to setup config parameter %s: parameter is not registered yet.", name.CString());
 		else
 			(IsEngine(name) ? engineParameters : shellParameters)[name] = value;
 	}
+	ConvertEngineParameters(engineParameters);
+}
 
+// Header and record table have fixed layout, variable length values are stored after the table
+bool Config::Initialize(Urho3D::VariantMap& engineParameters,
+						Urho3D::VariantMap& shellParameters,
+						Urho3D::Deserializer& source)
+{
+	if (source.ReadFileID() != BINARY_ID || source.ReadUInt() != BINARY_VERSION)
+		return false;
+	if (source.ReadUInt() != GetSchemaHash())
+	{
+		URHO3D_LOGINFO("Config parameters changed, binary config is outdated.");
+		return false;
+	}
+	const unsigned count = source.ReadUInt();
+	if (BINARY_HEADER_SIZE + count * BINARY_RECORD_SIZE > source.GetSize())
+		return false;
+
+	StringHash name;
+	VariantType type;
+	unsigned offset, size, position;
+	for (unsigned i = 0; i < count; ++i)
+	{
+		name = StringHash(source.ReadUInt());
+		type = static_cast<VariantType>(source.ReadUInt());
+		offset = source.ReadUInt();
+		size = source.ReadUInt();
+		// Parameters registered after startup (e.g. by plugins) are not part of schema
+		if (!index_.Contains(name) || GetType(name) != type || offset + size > source.GetSize())
+			continue;
+		position = source.GetPosition();
+		source.Seek(offset);
+		(IsEngine(name) ? engineParameters : shellParameters)[name] = source.ReadVariant(type);
+		source.Seek(position);
+	}
+	ConvertEngineParameters(engineParameters);
+	return true;
+}
+
+void Config::ConvertEngineParameters(Urho3D::VariantMap& engineParameters) const
+{
 	auto it = engineParameters.Find(ECP_RESOLUTION);
 	if (it != engineParameters.End())
 	{
@@ -74,9 +147,9 @@ void Config::Initialize(Urho3D::VariantMap& engineParameters,
 
 bool Config::Load(Urho3D::Deserializer& source)
 {
+	if (source.IsEof())
+		return true; // Empty file has nothing to override
 	const unsigned size = source.ReadUInt();
-	if (!size)
-		return false;
 	StringHash name;
 	Variant value;
 	for (unsigned i = 0; i < size; ++i)
@@ -90,15 +163,39 @@ bool Config::Load(Urho3D::Deserializer& source)
 
 bool Config::Save(Urho3D::Serializer& dest) const
 {
-	dest.WriteUInt(parameters_.Size());
-	for (const auto& it : parameters_)
+	dest.WriteUInt(records_.Size());
+	for (const Record& record : records_)
 	{
-		dest.WriteStringHash(it.first_);
-		dest.WriteVariant(it.second_->Read());
+		dest.WriteStringHash(record.hash_);
+		dest.WriteVariant(record.parameter_->Read());
 	}
 	return true;
 }
 
+bool Config::SaveBinary(Urho3D::Serializer& dest, unsigned schemaHash) const
+{
+	VectorBuffer values;
+	const unsigned valuesOffset = BINARY_HEADER_SIZE + records_.Size() * BINARY_RECORD_SIZE;
+	bool success = dest.WriteFileID(BINARY_ID);
+	success &= dest.WriteUInt(BINARY_VERSION);
+	success &= dest.WriteUInt(schemaHash);
+	success &= dest.WriteUInt(records_.Size());
+	Variant value;
+	unsigned offset;
+	for (const Record& record : records_)
+	{
+		value = record.parameter_->Read();
+		offset = values.GetPosition();
+		values.WriteVariantData(value);
+		success &= dest.WriteUInt(record.hash_.Value());
+		success &= dest.WriteUInt(value.GetType());
+		success &= dest.WriteUInt(valuesOffset + offset);
+		success &= dest.WriteUInt(values.GetPosition() - offset);
+	}
+	success &= dest.Write(values.GetData(), values.GetSize()) == values.GetSize();
+	return success;
+}
+
 bool Config::LoadXML(const Urho3D::XMLElement& source)
 {
 	String name;
@@ -111,7 +208,7 @@ bool Config::LoadXML(const Urho3D::XMLElement& source)
 			URHO3D_LOGWARNING("Failed to setup config parameter: name is empty.");
 		else if (value.IsEmpty())
 			URHO3D_LOGWARNINGF("Failed to setup config parameter %s: value is empty.", name.CString());
-		else if (!parameters_.Contains(name))
+		else if (!index_.Contains(name))
 			URHO3D_LOGWARNINGF("Failed to setup config parameter %s: parameter is not registered yet.", name.CString());
 		else
 			Apply(name, value);
@@ -122,11 +219,11 @@ bool Config::LoadXML(const Urho3D::XMLElement& source)
 bool Config::SaveXML(Urho3D::XMLElement& dest) const
 {
 	XMLElement parameter;
-	for (const auto& p : parameters_)
+	for (const Record& record : records_)
 	{
 		parameter = dest.CreateChild("parameter");
-		parameter.SetAttribute("name", names_.Find(p.first_)->second_);
-		parameter.SetVariant(p.second_->Read());
+		parameter.SetAttribute("name", record.name_);
+		parameter.SetVariant(record.parameter_->Read());
 	}
 	return true;
 }
@@ -144,7 +241,7 @@ bool Config::LoadJSON(const Urho3D::JSONValue& source)
 			URHO3D_LOGWARNING("Failed to setup config parameter: name is empty.");
 		else if (value.IsEmpty())
 			URHO3D_LOGWARNINGF("Failed to setup config parameter %s: value is empty.", name.CString());
-		else if (!parameters_.Contains(name))
+		else if (!index_.Contains(name))
 			URHO3D_LOGWARNINGF("Failed to setup config parameter %s: parameter is not registered yet.", name.CString());
 		else
 			Apply(name, value);
@@ -156,10 +253,10 @@ bool Config::SaveJSON(Urho3D::JSONValue& dest) const
 {
 	JSONArray array;
 	JSONValue parameter;
-	for (const auto& p : parameters_)
+	for (const Record& record : records_)
 	{
-		parameter.Set("name", names_.Find(p.first_)->second_);
-		parameter.SetVariant(p.second_->Read());
+		parameter.Set("name", record.name_);
+		parameter.SetVariant(record.parameter_->Read());
 		array.Push(parameter);
 	}
 	dest.Set("config", array);
@@ -173,40 +270,49 @@ void Config::Apply(const Urho3D::VariantMap& parameters)
 	ApplyComplex();
 }
 
+// Writers may be expensive (e.g. renderer reconfiguration), so unchanged values are not written again
 void Config::Apply(Urho3D::StringHash name, const Urho3D::Variant& value)
 {
-	auto it = parameters_.Find(name);
-	if (it != parameters_.End())
-		it->second_->Write(value);
+	const unsigned index = FindRecord(name);
+	if (index == M_MAX_UNSIGNED)
+		return;
+	Record& record = records_[index];
+	if (record.parameter_->Read() == value)
+		return;
+	record.parameter_->Write(value);
+	if (!changed_.Contains(record.name_))
+		changed_.Push(record.name_);
 }
 
+// Only storages with changed members are applied, changes since previous call are reported as single event
 void Config::ApplyComplex()
 {
 	for (auto& p : storages_)
 		p.second_->Apply();
+
+	if (changed_.Empty())
+		return;
+	using namespace ConfigChanged;
+	VariantMap& eventData = GetEventDataMap();
+	eventData[P_PARAMETERS] = changed_;
+	changed_.Clear();
+	SendEvent(E_CONFIGCHANGED, eventData);
 }
 
 void Config::RegisterSettingsTab(const Urho3D::String& tabName)
 {
-	if (!settings_.Contains(tabName))
-	{
-		settings_[tabName]; // Create default constructed object in map
-		names_[tabName] = tabName;
-	}
+	if (FindTab(tabName) == M_MAX_UNSIGNED)
+		tabs_.Push({tabName, tabName, records_.Size(), records_.Size()});
 	else
 		URHO3D_LOGWARNINGF("Failed to register already registered settings tab %s.", tabName.CString());
 }
 
+// Parameters of removed tab stay registered, they just are not listed in any tab
 void Config::RemoveSettingsTab(Urho3D::StringHash tab)
 {
-	auto itTab = settings_.Find(tab);
-	if (itTab != settings_.End())
-	{
-		const auto itParameter = parameters_.Find(tab);
-		if (itParameter == parameters_.End())
-			names_.Erase(tab);
-		settings_.Erase(itTab);
-	}
+	const unsigned index = FindTab(tab);
+	if (index != M_MAX_UNSIGNED)
+		tabs_.Erase(index);
 	else
 		URHO3D_LOGWARNING("Failed to remove non-existent settings tab.");
 }
@@ -214,21 +320,22 @@ void Config::RemoveSettingsTab(Urho3D::StringHash tab)
 Urho3D::StringVector Config::GetSettingsTabs() const
 {
 	StringVector ret;
-	ret.Reserve(settings_.Size());
-	for (const auto& p : settings_)
-		ret.Push(*names_[p.first_]);
+	ret.Reserve(tabs_.Size());
+	for (const SettingsTab& tab : tabs_)
+		ret.Push(tab.name_);
 	return ret;
 }
 
 Urho3D::StringVector Config::GetSettings(Urho3D::StringHash settingsTab) const
 {
-	const auto it = settings_.Find(settingsTab);
-	if (it != settings_.End())
+	const unsigned index = FindTab(settingsTab);
+	if (index != M_MAX_UNSIGNED)
 	{
+		const SettingsTab& tab = tabs_[index];
 		StringVector ret;
-		ret.Reserve(it->second_.Size());
-		for (StringHash setting : it->second_)
-			ret.Push(*names_[setting]);
+		ret.Reserve(tab.end_ - tab.begin_);
+		for (unsigned i = tab.begin_; i < tab.end_; ++i)
+			ret.Push(records_[i].name_);
 		return ret;
 	}
 	else
@@ -240,41 +347,58 @@ Urho3D::StringVector Config::GetSettings(Urho3D::StringHash settingsTab) const
 
 DynamicParameter* Config::GetParameter(Urho3D::StringHash parameter) const
 {
-	const auto it = parameters_.Find(parameter);
-	return it != parameters_.End() ? it->second_ : nullptr;
+	const unsigned index = FindRecord(parameter);
+	return index != M_MAX_UNSIGNED ? records_[index].parameter_.Get() : nullptr;
 }
 
+// Record is placed at the end of its tab range, so that every tab stays contiguous
 bool Config::RegisterParameter(DynamicParameter* parameter, const Urho3D::String& name, Urho3D::StringHash settingsTab)
 {
-	auto itSettingsTab = settings_.Find(settingsTab);
-	if (itSettingsTab == settings_.End())
+	const unsigned tabIndex = FindTab(settingsTab);
+	if (tabIndex == M_MAX_UNSIGNED)
 	{
 		URHO3D_LOGERRORF("Failed to register config parameter %s in unknown settings tab.", name.CString());
 		return false;
 	}
-	if (parameters_.Contains(name))
+	if (index_.Contains(name))
 	{
 		URHO3D_LOGERRORF("Failed to register already registered config parameter %s.", name.CString());
 		return false;
 	}
-	parameters_[name] = parameter;
-	names_[name] = name;
-	itSettingsTab->second_.Push(name);
+
+	const unsigned position = tabs_[tabIndex].end_;
+	records_.Insert(position,
+					{SharedPtr<DynamicParameter>(parameter),
+					 SharedPtr<EnumConstructor>(),
+					 name,
+					 name,
+					 parameter->GetType(),
+					 parameter->IsEngine()});
+	++tabs_[tabIndex].end_;
+	for (unsigned i = tabIndex + 1; i < tabs_.Size(); ++i)
+	{
+		++tabs_[i].begin_;
+		++tabs_[i].end_;
+	}
+	UpdateIndex(position);
 	return true;
 }
 
 void Config::RemoveParameter(Urho3D::StringHash parameter)
 {
-	auto itParameter = parameters_.Find(parameter);
-	if (itParameter != parameters_.End())
+	const unsigned index = FindRecord(parameter);
+	if (index != M_MAX_UNSIGNED)
 	{
-		auto itSetting = settings_.Find(itParameter->second_->GetSettingsTab());
-		if (itSetting == settings_.End())
-			names_.Erase(parameter);
-		else
-			settings_.Erase(itSetting);
-		enumConstructors_.Erase(itParameter->first_);
-		parameters_.Erase(itParameter);
+		for (SettingsTab& tab : tabs_)
+		{
+			if (tab.begin_ > index)
+				--tab.begin_;
+			if (tab.end_ > index)
+				--tab.end_;
+		}
+		index_.Erase(parameter);
+		records_.Erase(index);
+		UpdateIndex(index);
 	}
 	else
 		URHO3D_LOGWARNING("Failed to remove non-existent config parameter.");
@@ -282,15 +406,16 @@ void Config::RemoveParameter(Urho3D::StringHash parameter)
 
 EnumConstructor* Config::GetEnum(Urho3D::StringHash parameter) const
 {
-	const auto it = enumConstructors_.Find(parameter);
-	return it != enumConstructors_.End() ? it->second_ : nullptr;
+	const unsigned index = FindRecord(parameter);
+	return index != M_MAX_UNSIGNED ? records_[index].enum_.Get() : nullptr;
 }
 
 bool Config::RegisterEnum(EnumConstructor* constructor, Urho3D::StringHash parameter)
 {
-	if (parameters_.Contains(parameter))
+	const unsigned index = FindRecord(parameter);
+	if (index != M_MAX_UNSIGNED)
 	{
-		enumConstructors_[parameter] = constructor;
+		records_[index].enum_ = constructor;
 		return true;
 	}
 	else
@@ -300,7 +425,63 @@ bool Config::RegisterEnum(EnumConstructor* constructor, Urho3D::StringHash param
 	}
 }
 
-void Config::RemoveEnum(Urho3D::StringHash parameter) { enumConstructors_.Erase(parameter); }
+void Config::RemoveEnum(Urho3D::StringHash parameter)
+{
+	const unsigned index = FindRecord(parameter);
+	if (index != M_MAX_UNSIGNED)
+		records_[index].enum_.Reset();
+}
+
+void Config::InvalidateEnum(Urho3D::StringHash parameter)
+{
+	EnumConstructor* constructor = GetEnum(parameter);
+	if (constructor)
+		constructor->Invalidate();
+}
+
+void Config::InvalidateEnumOn(Urho3D::StringHash eventType, Urho3D::StringHash parameter)
+{
+	PODVector<StringHash>& parameters = enumEvents_[eventType];
+	if (parameters.Empty())
+		SubscribeToEvent(eventType, URHO3D_HANDLER(Config, OnEnumEvent));
+	if (!parameters.Contains(parameter))
+		parameters.Push(parameter);
+}
+
+// Enums of graphics, windowing or localization can be queried only from main thread
+void Config::PrecomputeEnums()
+{
+	UniquePtr<EnumJob> job(new EnumJob());
+	for (const Record& record : records_)
+		if (record.enum_ && !record.enum_->IsValid())
+		{
+			if (!record.enum_->IsThreadSafe())
+			{
+				if (!mainThreadEnums_.Contains(record.enum_))
+					mainThreadEnums_.Push(record.enum_);
+			}
+			else if (!enumJob_)
+			{
+				job->constructors_.Push(record.enum_);
+				job->versions_.Push(record.enum_->GetVersion());
+			}
+		}
+	if (!mainThreadEnums_.Empty())
+		SubscribeToEvent(E_UPDATE, URHO3D_HANDLER(Config, OnEnumUpdate));
+	if (job->constructors_.Empty())
+		return;
+	job->results_.Resize(job->constructors_.Size());
+
+	WorkQueue* queue = GetSubsystem<WorkQueue>();
+	enumWork_ = queue->GetFreeItem();
+	enumWork_->priority_ = 0;
+	enumWork_->workFunction_ = ConstructEnums;
+	enumWork_->aux_ = job.Get();
+	enumWork_->sendEvent_ = true;
+	enumJob_ = std::move(job);
+	SubscribeToEvent(E_WORKITEMCOMPLETED, URHO3D_HANDLER(Config, OnWorkItemCompleted));
+	queue->AddWorkItem(enumWork_);
+}
 
 Urho3D::WeakPtr<ComplexParameter> Config::GetComplexStorage(Urho3D::StringHash cathegory) const
 {
@@ -326,77 +507,93 @@ void Config::RemoveComplexStorage(Urho3D::StringHash cathegory) { storages_.Eras
 
 const Urho3D::String& Config::GetName(Urho3D::StringHash parameter) const
 {
-	const auto it = names_.Find(parameter);
-	return it != names_.End() ? it->second_ : Urho3D::String::EMPTY;
+	const unsigned index = FindRecord(parameter);
+	if (index != M_MAX_UNSIGNED)
+		return records_[index].name_;
+	const unsigned tab = FindTab(parameter);
+	return tab != M_MAX_UNSIGNED ? tabs_[tab].name_ : Urho3D::String::EMPTY;
 }
 
 Urho3D::VariantType Config::GetType(Urho3D::StringHash parameter) const
 {
-	const auto it = parameters_.Find(parameter);
-	return it != parameters_.End() ? it->second_->GetType() : Urho3D::VariantType::VAR_NONE;
+	const unsigned index = FindRecord(parameter);
+	return index != M_MAX_UNSIGNED ? records_[index].type_ : Urho3D::VariantType::VAR_NONE;
 }
 
 bool Config::IsEngine(Urho3D::StringHash parameter) const
 {
-	const auto it = parameters_.Find(parameter);
-	return it != parameters_.End() ? it->second_->IsEngine() : false;
+	const unsigned index = FindRecord(parameter);
+	return index != M_MAX_UNSIGNED ? records_[index].engine_ : false;
 }
 
-bool Config::IsEnum(Urho3D::StringHash parameter) const { return enumConstructors_.Contains(parameter); }
+bool Config::IsEnum(Urho3D::StringHash parameter) const { return GetEnum(parameter) != nullptr; }
 
 bool Config::IsLocalized(Urho3D::StringHash parameter) const
 {
-	const auto it = enumConstructors_.Find(parameter);
-	return it != parameters_.End() ? it->second_->IsLocalized() : false;
+	const EnumConstructor* constructor = GetEnum(parameter);
+	return constructor ? constructor->IsLocalized() : false;
 }
 
 Urho3D::Variant Config::ReadValue(Urho3D::StringHash parameter) const
 {
-	const auto it = parameters_.Find(parameter);
-	return it != parameters_.End() ? it->second_->Read() : Urho3D::Variant::EMPTY;
+	const unsigned index = FindRecord(parameter);
+	return index != M_MAX_UNSIGNED ? records_[index].parameter_->Read() : Urho3D::Variant::EMPTY;
 }
 
 void Config::WriteValue(Urho3D::StringHash parameter, const Urho3D::Variant& value)
 {
-	const auto it = parameters_.Find(parameter);
-	if (it != parameters_.End())
-		it->second_->Write(value);
+	const unsigned index = FindRecord(parameter);
+	if (index != M_MAX_UNSIGNED)
+		records_[index].parameter_->Write(value);
 }
 
-EnumVector Config::ConstructEnum(Urho3D::StringHash parameter) const
+const EnumVector& Config::ConstructEnum(Urho3D::StringHash parameter) const
 {
-	const auto it = enumConstructors_.Find(parameter);
-	return it != enumConstructors_.End() ? it->second_->Create() : EnumVector{};
+	EnumConstructor* constructor = GetEnum(parameter);
+	return constructor ? constructor->Get() : emptyEnum;
+}
+
+// Order independent, so that registration order of parameters does not matter
+unsigned Config::GetSchemaHash() const
+{
+	PODVector<unsigned> keys;
+	keys.Reserve(records_.Size());
+	for (const Record& record : records_)
+		keys.Push(record.hash_.Value() ^ (static_cast<unsigned>(record.type_) << 24u)
+				  ^ (record.engine_ ? 0x80000000u : 0u));
+	Sort(keys.Begin(), keys.End());
+
+	unsigned hash = BINARY_VERSION;
+	for (unsigned key : keys)
+		for (unsigned i = 0; i < sizeof(key); ++i)
+			hash = SDBMHash(hash, static_cast<unsigned char>(key >> (i * 8u)));
+	return hash;
 }
 
 Urho3D::String Config::GetDebugString() const
 {
 	String ret;
-	StringVector tabs = GetSettingsTabs();
-	StringVector parameters;
 	Variant value;
 	EnumVector enumVector;
-	SharedPtr<DynamicParameter> parameter;
-	for (const String& tabName : tabs)
+	for (const SettingsTab& tab : tabs_)
 	{
-		ret.Append(tabName).Append('\n');
-		parameters = GetSettings(tabName);
-		for (const String& parameterName : parameters)
+		ret.Append(tab.name_).Append('\n');
+		for (unsigned i = tab.begin_; i < tab.end_; ++i)
 		{
-			parameter = *parameters_[parameterName];
-			value = parameter->Read();
-			ret.Append("\t").Append(parameterName).Append('\n');
+			const Record& record = records_[i];
+			value = record.parameter_->Read();
+			ret.Append("\t").Append(record.name_).Append('\n');
 			ret.Append("\t\tType  = ").Append(value.GetTypeName()).Append('\n');
 			ret.Append("\t\tValue = ").Append(value.ToString()).Append('\n');
 			ret.Append("\t\tStore = ");
-			if (parameter->IsEngine())
+			if (record.engine_)
 				ret.Append("ENGINE\n");
 			else
 				ret.Append("CUSTOM\n");
-			if (IsEnum(parameterName))
+			if (record.enum_)
 			{
 				ret.Append("\t\tEnum Variants:\n");
-				enumVector = (*enumConstructors_[parameterName])->Create();
+				enumVector = record.enum_->Get();
 				for (const EnumVariant& enumVariant : enumVector)
 					ret.Append("\t\t\t")
 						.Append(enumVariant.caption_)
@@ -409,6 +606,68 @@ Urho3D::String Config::GetDebugString() const
 	return ret;
 }
 
+unsigned Config::FindRecord(Urho3D::StringHash parameter) const
+{
+	const auto it = index_.Find(parameter);
+	return it != index_.End() ? it->second_ : M_MAX_UNSIGNED;
+}
+
+// There are few tabs, linear search is cheaper than hashing
+unsigned Config::FindTab(Urho3D::StringHash tab) const
+{
+	for (unsigned i = 0; i < tabs_.Size(); ++i)
+		if (tabs_[i].hash_ == tab)
+			return i;
+	return M_MAX_UNSIGNED;
+}
+
+void Config::UpdateIndex(unsigned first)
+{
+	for (unsigned i = first; i < records_.Size(); ++i)
+		index_[records_[i].hash_] = i;
+}
+
+void Config::OnEnumEvent(Urho3D::StringHash eventType, Urho3D::VariantMap&)
+{
+	const auto it = enumEvents_.Find(eventType);
+	if (it != enumEvents_.End())
+		for (StringHash parameter : it->second_)
+			InvalidateEnum(parameter);
+}
+
+// Enums constructed on main thread meanwhile or invalidated since job was queued keep their state
+void Config::OnWorkItemCompleted(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace WorkItemCompleted;
+	if (!enumJob_ || eventData[P_ITEM].GetPtr() != enumWork_.Get())
+		return;
+
+	for (unsigned i = 0; i < enumJob_->constructors_.Size(); ++i)
+		enumJob_->constructors_[i]->Store(std::move(enumJob_->results_[i]), enumJob_->versions_[i]);
+	enumJob_.Reset();
+	enumWork_.Reset();
+	UnsubscribeFromEvent(E_WORKITEMCOMPLETED);
+}
+
+void Config::OnEnumUpdate(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	if (!mainThreadEnums_.Empty())
+	{
+		mainThreadEnums_.Front()->Get();
+		mainThreadEnums_.Erase(0);
+	}
+	if (mainThreadEnums_.Empty())
+		UnsubscribeFromEvent(E_UPDATE);
+}
+
+// Worker thread: only job and thread-safe enum constructors are used
+void Config::ConstructEnums(const Urho3D::WorkItem* item, unsigned)
+{
+	EnumJob* job = static_cast<EnumJob*>(item->aux_);
+	for (unsigned i = 0; i < job->constructors_.Size(); ++i)
+		job->results_[i] = job->constructors_[i]->Create();
+}
+
 bool Config::RegisterSimpleParameter(const Urho3D::String& name,
 									 Urho3D::VariantType type,
 									 Urho3D::StringHash settingsTab,
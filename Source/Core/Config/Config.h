@@ -25,6 +25,7 @@
 
 #include <Urho3D/Core/Object.h>
 #include <functional>
+#include "ConfigParam.h"
 #include "DynamicParameter.h"
 #include "EnumVariant.h"
 #include "U3SCoreAPI.h"
@@ -35,6 +36,7 @@ class Deserializer;
 class JSONValue;
 class Serializer;
 class UIElement;
+class WorkItem;
 class XMLElement;
 } // namespace Urho3D
 
@@ -48,11 +50,15 @@ public:
 	using ComplexWriterFunc = std::function<void(const Urho3D::VariantMap&)>;
 	using EnumConstructorFunc = std::function<EnumVector()>;
 
-	using Urho3D::Object::Object;
+	explicit Config(Urho3D::Context* context);
+	~Config();
 
 	void Initialize(Urho3D::VariantMap& engineParameters,
 					Urho3D::VariantMap& shellParameters,
 					const Urho3D::XMLElement& source);
+	bool Initialize(Urho3D::VariantMap& engineParameters,
+					Urho3D::VariantMap& shellParameters,
+					Urho3D::Deserializer& source);
 
 	bool Load(Urho3D::Deserializer& source);
 	bool Save(Urho3D::Serializer& dest) const;
@@ -60,6 +66,8 @@ public:
 	bool SaveXML(Urho3D::XMLElement& dest) const;
 	bool LoadJSON(const Urho3D::JSONValue& source);
 	bool SaveJSON(Urho3D::JSONValue& dest) const;
+	// Versioned cache read by Initialize(), schemaHash is the one of parameters registered at startup
+	bool SaveBinary(Urho3D::Serializer& dest, unsigned schemaHash) const;
 
 	void Apply(const Urho3D::VariantMap& parameters);
 	void Apply(Urho3D::StringHash name, const Urho3D::Variant& value);
@@ -71,12 +79,19 @@ public:
 	Urho3D::StringVector GetSettings(Urho3D::StringHash settingsTab) const;
 
 	DynamicParameter* GetParameter(Urho3D::StringHash parameter) const;
+	// Empty handle if parameter does not exist or was not registered by RegisterValueParameter() with same type
+	template <typename T> ConfigParam<T> GetParam(Urho3D::StringHash parameter) const;
 	bool RegisterParameter(DynamicParameter* parameter, const Urho3D::String& name, Urho3D::StringHash settingsTab);
 	void RemoveParameter(Urho3D::StringHash parameter);
 
 	EnumConstructor* GetEnum(Urho3D::StringHash parameter) const;
 	bool RegisterEnum(EnumConstructor* constructor, Urho3D::StringHash parameter);
 	void RemoveEnum(Urho3D::StringHash parameter);
+	void InvalidateEnum(Urho3D::StringHash parameter);
+	// Variants of parameter are constructed again after every eventType event
+	void InvalidateEnumOn(Urho3D::StringHash eventType, Urho3D::StringHash parameter);
+	// Constructs enums not cached yet: thread-safe ones in worker thread, the rest on main thread one per frame
+	void PrecomputeEnums();
 
 	Urho3D::WeakPtr<ComplexParameter> GetComplexStorage(Urho3D::StringHash cathegory) const;
 	bool RegisterComplexStorage(ComplexParameter* storage, Urho3D::StringHash cathegory);
@@ -89,16 +104,52 @@ public:
 	bool IsLocalized(Urho3D::StringHash parameter) const;
 	Urho3D::Variant ReadValue(Urho3D::StringHash parameter) const;
 	void WriteValue(Urho3D::StringHash parameter, const Urho3D::Variant& value);
-	EnumVector ConstructEnum(Urho3D::StringHash parameter) const;
+	const EnumVector& ConstructEnum(Urho3D::StringHash parameter) const;
 
+	unsigned GetSchemaHash() const;
 	Urho3D::String GetDebugString() const;
 
 private:
-	Urho3D::HashMap<Urho3D::StringHash, Urho3D::SharedPtr<DynamicParameter>> parameters_;
-	Urho3D::HashMap<Urho3D::StringHash, Urho3D::SharedPtr<EnumConstructor>> enumConstructors_;
+	struct Record
+	{
+		Urho3D::SharedPtr<DynamicParameter> parameter_;
+		Urho3D::SharedPtr<EnumConstructor> enum_; // Null if parameter is not enum
+		Urho3D::String name_;
+		Urho3D::StringHash hash_;
+		Urho3D::VariantType type_;
+		bool engine_;
+	};
+
+	struct SettingsTab
+	{
+		Urho3D::String name_;
+		Urho3D::StringHash hash_;
+		unsigned begin_; // First record of tab
+		unsigned end_;	 // Past last record of tab
+	};
+
+	struct EnumJob;
+
+	void ConvertEngineParameters(Urho3D::VariantMap& engineParameters) const;
+	unsigned FindRecord(Urho3D::StringHash parameter) const;
+	unsigned FindTab(Urho3D::StringHash tab) const;
+	void UpdateIndex(unsigned first);
+
+	void OnEnumEvent(Urho3D::StringHash eventType, Urho3D::VariantMap&);
+	void OnWorkItemCompleted(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+	void OnEnumUpdate(Urho3D::StringHash, Urho3D::VariantMap&);
+
+	static void ConstructEnums(const Urho3D::WorkItem* item, unsigned threadIndex);
+
+	Urho3D::Vector<Record> records_;						// Grouped by settings tab
+	Urho3D::Vector<SettingsTab> tabs_;						// In registration order
+	Urho3D::HashMap<Urho3D::StringHash, unsigned> index_;	// Parameter -> Record
 	Urho3D::HashMap<Urho3D::StringHash, Urho3D::SharedPtr<ComplexParameter>> storages_;
-	Urho3D::HashMap<Urho3D::StringHash, Urho3D::PODVector<Urho3D::StringHash>> settings_;
-	Urho3D::StringMap names_;
+	Urho3D::HashMap<Urho3D::StringHash, Urho3D::PODVector<Urho3D::StringHash>> enumEvents_;
+	Urho3D::StringVector changed_;		 // Applied since last ApplyComplex()
+	Urho3D::UniquePtr<EnumJob> enumJob_; // Precomputation in progress
+	Urho3D::SharedPtr<Urho3D::WorkItem> enumWork_;
+	Urho3D::Vector<Urho3D::SharedPtr<EnumConstructor>> mainThreadEnums_; // Waiting for precomputation
 
 public:
 	bool RegisterSimpleParameter(const Urho3D::String& name,
@@ -151,6 +202,13 @@ public:
 									  SimpleReaderFunc&& reader,
 									  EnumVector&& enumVector);
 
+	template <typename T>
+	ConfigParam<T> RegisterValueParameter(const Urho3D::String& name,
+										  Urho3D::StringHash settingsTab,
+										  bool isEngine,
+										  const T& defaultValue,
+										  typename ValueParameter<T>::ChangedFunc&& changed = {});
+
 	ComplexParameter*
 	RegisterBinaryComplexStorage(Urho3D::StringHash cathegory, bool engine, ComplexWriterFunc&& writer);
 
@@ -158,4 +216,21 @@ public:
 	static Urho3D::String ResToStr(const Urho3D::IntVector3& res);
 };
 
+template <typename T> ConfigParam<T> Config::GetParam(Urho3D::StringHash parameter) const
+{
+	return ConfigParam<T>(dynamic_cast<ValueParameter<T>*>(GetParameter(parameter)));
+}
+
+template <typename T>
+ConfigParam<T> Config::RegisterValueParameter(const Urho3D::String& name,
+											  Urho3D::StringHash settingsTab,
+											  bool isEngine,
+											  const T& defaultValue,
+											  typename ValueParameter<T>::ChangedFunc&& changed)
+{
+	Urho3D::SharedPtr<ValueParameter<T>> parameter(
+		new ValueParameter<T>(defaultValue, std::move(changed), settingsTab, isEngine));
+	return RegisterParameter(parameter, name, settingsTab) ? ConfigParam<T>(parameter) : ConfigParam<T>();
+}
+
 #endif // CONFIG_H
@@ -4,13 +4,19 @@
 static const Urho3D::String ST_AUDIO = "Audio";
 static const Urho3D::String ST_GAME = "Game";
 static const Urho3D::String ST_INPUT = "Input";
+static const Urho3D::String ST_SERVER = "Server";
 static const Urho3D::String ST_VIDEO = "Video";
 
 static const Urho3D::String ECP_RESOLUTION = "Resolution";
 static const Urho3D::String ECP_WINDOW_MODE = "WindowMode";
 static const Urho3D::String ECP_VIDEO_MODE = "VideoMode";
 
+static const Urho3D::String CP_ASYNC_LOADING_MS = "AsyncLoadingMs";
+static const Urho3D::String CP_AUTOSAVE_INTERVAL = "AutosaveInterval";
+static const Urho3D::String CP_INTEREST_RADIUS = "InterestRadius";
 static const Urho3D::String CP_LANGUAGE = "Language";
+static const Urho3D::String CP_MAX_PLAYERS = "MaxPlayers";
+static const Urho3D::String CP_NETWORK_RATE = "NetworkRate";
 static const Urho3D::String CP_SHADOW_QUALITY = "ShadowQuality";
 static const Urho3D::String CP_SHADOW_RESOLUTION = "ShadowResolution";
 static const Urho3D::String CP_SOUND_MASTER = "SoundMaster";
@@ -18,5 +24,6 @@ static const Urho3D::String CP_SOUND_EFFECT = "SoundEffect";
 static const Urho3D::String CP_SOUND_AMBIENT = "SoundAmbient";
 static const Urho3D::String CP_SOUND_VOICE = "SoundVoice";
 static const Urho3D::String CP_SOUND_MUSIC = "SoundMusic";
+static const Urho3D::String CP_TICK_RATE = "TickRate";
 
 #endif // CONFIGDEFS_H
@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef CONFIGPARAM_H
+#define CONFIGPARAM_H
+
+#include <functional>
+#include "DynamicParameter.h"
+
+// Parameter holding its value inline, Variant is used only by UI and serialization.
+template <typename T> class ValueParameter : public DynamicParameter
+{
+public:
+	using ChangedFunc = std::function<void(const T&)>;
+
+	ValueParameter(const T& value, ChangedFunc&& changed, Urho3D::StringHash settingsTab, bool engine)
+		: DynamicParameter(Urho3D::GetVariantType<T>(), settingsTab, engine)
+		, changed_(std::move(changed))
+		, value_(value)
+	{
+	}
+
+	Urho3D::Variant Read() override { return Urho3D::Variant(value_); }
+	void Write(const Urho3D::Variant& value) override { Set(value.Get<T>()); }
+
+	void Set(const T& value)
+	{
+		if (value_ == value)
+			return;
+		value_ = value;
+		if (changed_)
+			changed_(value_);
+	}
+	const T& GetValue() const noexcept { return value_; }
+
+private:
+	const ChangedFunc changed_;
+	T value_;
+};
+
+// Typed handle resolved once, reading through it is a single load without hashing or Variant boxing.
+template <typename T> class ConfigParam
+{
+public:
+	ConfigParam()
+		: value_(nullptr)
+	{
+	}
+	explicit ConfigParam(ValueParameter<T>* parameter)
+		: parameter_(parameter)
+		, value_(parameter ? &parameter->GetValue() : nullptr)
+	{
+	}
+
+	// Bypasses Config::Apply(), so no E_CONFIGCHANGED is sent
+	void Set(const T& value) { parameter_->Set(value); }
+
+	const T& Get() const noexcept { return *value_; }
+	operator const T&() const noexcept { return *value_; }
+	bool IsValid() const noexcept { return value_ != nullptr; }
+
+private:
+	Urho3D::SharedPtr<ValueParameter<T>> parameter_;
+	const T* value_;
+};
+
+#endif // CONFIGPARAM_H
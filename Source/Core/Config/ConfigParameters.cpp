@@ -20,7 +20,9 @@
 // THE SOFTWARE.
 //
 
+#include <Urho3D/Network/Network.h>
 #include "Config.h"
+#include "ConfigDefs.h"
 
 #if defined(__GNUC__) || defined(__GNUG__)
 #pragma GCC diagnostic push
@@ -32,7 +34,35 @@
 #pragma clang diagnostic ignored "-Wsign-promo"
 #endif // defined(__clang__)
 
-void RegisterServerParameters(Config*) {}
+#define DEFAULT_ASYNC_LOADING_MS 5u
+#define DEFAULT_AUTOSAVE_INTERVAL 0.0f
+#define DEFAULT_INTEREST_RADIUS 0.0f
+#define DEFAULT_MAX_PLAYERS 128u
+#define DEFAULT_TICK_RATE 60u
+
+using namespace Urho3D;
+
+void RegisterServerParameters(Config* config)
+{
+	config->RegisterSettingsTab(ST_SERVER);
+	{
+		// Held by config itself, ShellConfigurator reads them through handles
+		config->RegisterValueParameter<unsigned>(CP_MAX_PLAYERS, ST_SERVER, false, DEFAULT_MAX_PLAYERS);
+		config->RegisterValueParameter<unsigned>(CP_TICK_RATE, ST_SERVER, false, DEFAULT_TICK_RATE);
+
+		config->RegisterSimpleParameter(
+			CP_NETWORK_RATE,
+			VAR_INT,
+			ST_SERVER,
+			false,
+			[config]() { return config->GetSubsystem<Network>()->GetUpdateFps(); },
+			[config](const Variant& value) { config->GetSubsystem<Network>()->SetUpdateFps(value.GetInt()); });
+
+		config->RegisterValueParameter<float>(CP_INTEREST_RADIUS, ST_SERVER, false, DEFAULT_INTEREST_RADIUS);
+		config->RegisterValueParameter<unsigned>(CP_ASYNC_LOADING_MS, ST_SERVER, false, DEFAULT_ASYNC_LOADING_MS);
+		config->RegisterValueParameter<float>(CP_AUTOSAVE_INTERVAL, ST_SERVER, false, DEFAULT_AUTOSAVE_INTERVAL);
+	}
+}
 
 #if defined(__GNUC__) || defined(__GNUG__)
 #pragma GCC diagnostic pop
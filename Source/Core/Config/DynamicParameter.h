@@ -65,6 +65,7 @@ public:
 		{
 			ApplyImpl();
 			parameters_.Clear();
+			changed_ = false;
 		}
 	}
 
@@ -74,6 +75,7 @@ public:
 		changed_ = true;
 	}
 
+	const Urho3D::Variant* GetPending(Urho3D::StringHash name) const { return parameters_[name]; }
 	bool IsEngine() const { return engine_; }
 
 protected:
@@ -78,17 +78,48 @@ class EnumConstructor : public Urho3D::RefCounted
 {
 public:
 	EnumConstructor(bool localized)
-		: localized_(localized)
+		: version_(0)
+		, localized_(localized)
+		, valid_(false)
 	{
 	}
 
 	virtual ~EnumConstructor() {}
 	virtual EnumVector Create() = 0;
+	// Create() may run in worker thread: touches no subsystems, localization, graphics or windowing
+	virtual bool IsThreadSafe() const { return false; }
 
+	// Variants are constructed once and reused until invalidated
+	const EnumVector& Get()
+	{
+		if (!valid_)
+			Store(Create(), version_);
+		return cache_;
+	}
+	// Variants constructed before invalidation (e.g. in worker thread) are dropped
+	void Store(EnumVector&& enumVector, unsigned version)
+	{
+		if (valid_ || version != version_)
+			return;
+		cache_ = std::move(enumVector);
+		valid_ = true;
+	}
+	void Invalidate()
+	{
+		cache_.Clear();
+		valid_ = false;
+		++version_;
+	}
+
+	unsigned GetVersion() const { return version_; }
 	bool IsLocalized() const { return localized_; }
+	bool IsValid() const { return valid_; }
 
 private:
+	EnumVector cache_;
+	unsigned version_;
 	bool localized_;
+	bool valid_;
 };
 
 class StaticEnumConstructor : public EnumConstructor
@@ -101,6 +132,7 @@ public:
 	}
 
 	EnumVector Create() override { return enumVector_; }
+	bool IsThreadSafe() const override { return true; }
 
 private:
 	const EnumVector enumVector_;
@@ -111,16 +143,19 @@ class BinaryEnumConstructor : public EnumConstructor
 public:
 	using ConstructorFunc = std::function<EnumVector()>;
 
-	BinaryEnumConstructor(ConstructorFunc&& constructor, bool localized)
+	BinaryEnumConstructor(ConstructorFunc&& constructor, bool localized, bool threadSafe = false)
 		: EnumConstructor(localized)
 		, constructor_(std::move(constructor))
+		, threadSafe_(threadSafe)
 	{
 	}
 
 	EnumVector Create() override { return constructor_(); }
+	bool IsThreadSafe() const override { return threadSafe_; }
 
 private:
 	const ConstructorFunc constructor_;
+	const bool threadSafe_;
 };
 
 #endif // ENUMVARIANT_H
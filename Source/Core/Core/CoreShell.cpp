@@ -23,11 +23,14 @@
 #include <Urho3D/AngelScript/Script.h>
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/StringUtils.h>
 #include <Urho3D/Urho3DConfig.h>
 #include "Config/Config.h"
 #include "CoreShell.h"
 #include "Input/ActionsRegistry.h"
 #include "Input/InputReceiver.h"
+#include "Network/NetworkStats.h"
+#include "Network/SaveGame.h"
 #include "Plugin/BinaryPlugin.h"
 #include "Plugin/PluginsRegistry.h"
 #include "ShellConfigurator.h"
@@ -59,6 +62,8 @@ CoreShell::CoreShell(Urho3D::Context* context)
 #endif // URHO3D_ANGELSCRIPT
 
 	context_->RegisterSubsystem<ActionsRegistry>();
+	context_->RegisterSubsystem<NetworkStats>();
+	context_->RegisterSubsystem<SaveGame>();
 
 	PluginsRegistry* plugins = context_->RegisterSubsystem<PluginsRegistry>();
 	plugins->RegisterPluginFactory<BinaryPlugin>();
@@ -71,6 +76,7 @@ CoreShell::CoreShell(Urho3D::Context* context)
 
 CoreShell::~CoreShell()
 {
+	context_->RemoveSubsystem<SaveGame>();
 	context_->RemoveSubsystem<ShellConfigurator>();
 	context_->RemoveSubsystem<PluginsRegistry>();
 }
@@ -106,6 +112,11 @@ void CoreShell::ParseParameters()
 				shellParameters_[SP_APP_NAME] = value;
 				++i;
 			}
+			else if (argument == "bots")
+			{
+				shellParameters_[SP_BOTS] = ToUInt(value);
+				++i;
+			}
 			else if (argument == "client")
 			{
 				shellParameters_[SP_CLIENT] = value;
@@ -116,6 +127,8 @@ void CoreShell::ParseParameters()
 				shellParameters_[SP_GAME_LIB] = value;
 				++i;
 			}
+			else if (argument == "jointest")
+				shellParameters_[SP_JOIN_TEST] = true;
 			else if (argument == "scene")
 			{
 				shellParameters_[SP_SCENE] = value;
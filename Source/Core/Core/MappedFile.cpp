@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/Math/MathDefs.h>
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+using namespace Urho3D;
+
+MappedFile::MappedFile()
+	: data_(nullptr)
+	, size_(0)
+#ifdef _WIN32
+	, file_(INVALID_HANDLE_VALUE)
+	, mapping_(nullptr)
+#endif // _WIN32
+{
+}
+
+MappedFile::~MappedFile() { Close(); }
+
+bool MappedFile::Open(const Urho3D::String& fileName)
+{
+	Close();
+#ifdef _WIN32
+	file_ = CreateFileW(GetWideNativePath(fileName).CString(),
+						GENERIC_READ,
+						FILE_SHARE_READ,
+						nullptr,
+						OPEN_EXISTING,
+						FILE_ATTRIBUTE_NORMAL,
+						nullptr);
+	if (file_ == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file_, &size) || !size.QuadPart || size.QuadPart > M_MAX_INT)
+	{
+		Close();
+		return false;
+	}
+	mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping_)
+	{
+		Close();
+		return false;
+	}
+	data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+	if (!data_)
+	{
+		Close();
+		return false;
+	}
+	size_ = static_cast<unsigned>(size.QuadPart);
+#else
+	const int fd = open(GetNativePath(fileName).CString(), O_RDONLY);
+	if (fd == -1)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) == -1 || !st.st_size || st.st_size > M_MAX_INT)
+	{
+		close(fd);
+		return false;
+	}
+	void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); // Mapping keeps its own reference to file
+	if (data == MAP_FAILED)
+		return false;
+	data_ = static_cast<const unsigned char*>(data);
+	size_ = static_cast<unsigned>(st.st_size);
+#endif // _WIN32
+	return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (data_)
+		UnmapViewOfFile(data_);
+	if (mapping_)
+		CloseHandle(mapping_);
+	if (file_ != INVALID_HANDLE_VALUE)
+		CloseHandle(file_);
+	mapping_ = nullptr;
+	file_ = INVALID_HANDLE_VALUE;
+#else
+	if (data_)
+		munmap(const_cast<unsigned char*>(data_), size_);
+#endif // _WIN32
+	data_ = nullptr;
+	size_ = 0;
+}
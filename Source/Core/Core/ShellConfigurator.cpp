@@ -22,12 +22,16 @@
 
 #include <Urho3D/Container/Str.h>
 #include <Urho3D/Engine/EngineDefs.h>
+#include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
 #include <Urho3D/Resource/JSONFile.h>
 #include <Urho3D/Resource/XMLFile.h>
 #include <filesystem>
 #include "Config/Config.h"
+#include "Config/ConfigDefs.h"
+#include "MappedFile.h"
 #include "Plugin/PluginsRegistry.h"
 #include "ShellConfigurator.h"
 #include "ShellDefs.h"
@@ -46,6 +50,12 @@ ShellConfigurator::ShellConfigurator(Urho3D::Context* context)
 	, gameName_(DEFAULT_GAME_NAME)
 	, profileName_(DEFAULT_PROFILE)
 	, userDataPath_(DEFAULT_USER_DATA_PATH)
+	, asyncLoadingMs_(GetSubsystem<Config>()->GetParam<unsigned>(CP_ASYNC_LOADING_MS))
+	, maxPlayers_(GetSubsystem<Config>()->GetParam<unsigned>(CP_MAX_PLAYERS))
+	, tickRate_(GetSubsystem<Config>()->GetParam<unsigned>(CP_TICK_RATE))
+	, interestRadius_(GetSubsystem<Config>()->GetParam<float>(CP_INTEREST_RADIUS))
+	, autosaveInterval_(GetSubsystem<Config>()->GetParam<float>(CP_AUTOSAVE_INTERVAL))
+	, schemaHash_(0)
 	, port_(27500)
 	, client_(false)
 {
@@ -77,18 +87,43 @@ void ShellConfigurator::Initialize(Urho3D::VariantMap& engineParameters,
 	else
 		fileSystem->CreateDir(path);
 
+	schemaHash_ = GetSubsystem<Config>()->GetSchemaHash();
 	if (InitProfile())
 	{
-		path = GetConfigFilename();
-		XMLFile file(context_);
-		if (GetSubsystem<FileSystem>()->FileExists(path) && file.LoadFile(path))
-		{
-			GetSubsystem<Config>()->Initialize(engineParameters, shellParameters, file.GetRoot(CONFIG_ROOT));
+		if (LoadBinaryConfig(engineParameters, shellParameters))
 			engineParameters[EP_LOG_NAME] = GetLogsFilename();
+		else
+		{
+			path = GetConfigFilename();
+			XMLFile file(context_);
+			if (fileSystem->FileExists(path) && file.LoadFile(path))
+			{
+				GetSubsystem<Config>()->Initialize(engineParameters, shellParameters, file.GetRoot(CONFIG_ROOT));
+				engineParameters[EP_LOG_NAME] = GetLogsFilename();
+			}
 		}
 	}
 }
 
+// XML stays the editable copy, binary one is used only while it is not older than XML
+bool ShellConfigurator::LoadBinaryConfig(Urho3D::VariantMap& engineParameters, Urho3D::VariantMap& shellParameters)
+{
+	FileSystem* fileSystem = GetSubsystem<FileSystem>();
+	const String binaryPath = GetBinaryConfigFilename();
+	const String path = GetConfigFilename();
+	if (!fileSystem->FileExists(binaryPath))
+		return false;
+	if (fileSystem->FileExists(path)
+		&& fileSystem->GetLastModifiedTime(path) > fileSystem->GetLastModifiedTime(binaryPath))
+		return false;
+
+	MappedFile file;
+	if (!file.Open(binaryPath))
+		return false;
+	MemoryBuffer buffer(file.GetData(), file.GetSize());
+	return GetSubsystem<Config>()->Initialize(engineParameters, shellParameters, buffer);
+}
+
 void ShellConfigurator::LoadProfile(const Urho3D::String& profileName)
 {
 	SaveProfile();
@@ -110,7 +145,11 @@ bool ShellConfigurator::InitProfile()
 	if (!fileSystem->DirExists(userDataPath_))
 		fileSystem->CreateDir(userDataPath_);
 
-	String path = GetInputPath();
+	String path = GetCachePath();
+	if (!fileSystem->DirExists(path))
+		fileSystem->CreateDir(path);
+
+	path = GetInputPath();
 	if (!fileSystem->DirExists(path))
 		fileSystem->CreateDir(path);
 
@@ -122,6 +161,10 @@ bool ShellConfigurator::InitProfile()
 	if (!fileSystem->DirExists(path))
 		fileSystem->CreateDir(path);
 
+	path = GetRecordingsPath();
+	if (!fileSystem->DirExists(path))
+		fileSystem->CreateDir(path);
+
 	path = GetSavesPath();
 	if (!fileSystem->DirExists(path))
 		fileSystem->CreateDir(path);
@@ -137,8 +180,14 @@ void ShellConfigurator::SaveProfile() const
 {
 	XMLFile file(context_);
 	XMLElement root = file.CreateRoot(CONFIG_ROOT);
-	GetSubsystem<Config>()->SaveXML(root);
+	const Config* config = GetSubsystem<Config>();
+	config->SaveXML(root);
 	file.SaveFile(GetConfigFilename());
+
+	// Written after XML, so that its modification time is not older
+	File binary(context_, GetBinaryConfigFilename(), FILE_WRITE);
+	if (!binary.IsOpen() || !config->SaveBinary(binary, schemaHash_ ? schemaHash_ : config->GetSchemaHash()))
+		URHO3D_LOGWARNING("Failed to save binary config.");
 }
 
 void ShellConfigurator::CreateProfile(const Urho3D::String& profileName)
@@ -153,6 +202,8 @@ void ShellConfigurator::RemoveProfile(const Urho3D::String& profileName)
 	std::filesystem::remove_all(path.CString());
 }
 
+Urho3D::String ShellConfigurator::GetBinaryConfigFilename() const { return GetConfigPath() + appName_ + ".bin"; }
+Urho3D::String ShellConfigurator::GetCachePath() const { return userDataPath_ + "Cache/"; }
 Urho3D::String ShellConfigurator::GetConfigFilename() const { return GetConfigPath() + appName_ + ".xml"; }
 Urho3D::String ShellConfigurator::GetConfigPath() const { return userDataPath_ + "Config/"; }
 Urho3D::String ShellConfigurator::GetInputPath() const { return userDataPath_ + "Input/"; }
@@ -161,6 +212,7 @@ Urho3D::String ShellConfigurator::GetLogsPath() const { return userDataPath_ + "
 Urho3D::String ShellConfigurator::GetPluginsFilename() const { return GetPluginsPath() + "Plugins.txt"; }
 Urho3D::String ShellConfigurator::GetPluginsPath() const { return userDataPath_ + "Plugins/"; }
 Urho3D::String ShellConfigurator::GetProfileFilename() const { return GetGameDataPath() + "Profile.txt"; }
+Urho3D::String ShellConfigurator::GetRecordingsPath() const { return userDataPath_ + "Recordings/"; }
 Urho3D::String ShellConfigurator::GetSavesPath() const { return userDataPath_ + "Saves/"; }
 
 void ShellConfigurator::CreatePath(const Urho3D::String& path) const
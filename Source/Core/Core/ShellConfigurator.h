@@ -24,6 +24,7 @@
 #define SHELLCONFIGURATOR_H
 
 #include <Urho3D/Core/Object.h>
+#include "Config/ConfigParam.h"
 #include "U3SCoreAPI.h"
 
 class U3SCOREAPI_EXPORT ShellConfigurator : public Urho3D::Object
@@ -43,6 +44,8 @@ public:
 	void CreateProfile(const Urho3D::String& profileName);
 	void RemoveProfile(const Urho3D::String& profileName);
 
+	Urho3D::String GetBinaryConfigFilename() const;
+	Urho3D::String GetCachePath() const;
 	Urho3D::String GetConfigFilename() const;
 	Urho3D::String GetConfigPath() const;
 	Urho3D::String GetInputPath() const;
@@ -51,27 +54,47 @@ public:
 	Urho3D::String GetPluginsFilename() const;
 	Urho3D::String GetPluginsPath() const;
 	Urho3D::String GetProfileFilename() const;
+	Urho3D::String GetRecordingsPath() const;
 	Urho3D::String GetSavesPath() const;
 
+	// Server parameters are held by Config, these bypass Config::Apply() like ConfigParam::Set()
+	void SetAsyncLoadingMs(unsigned asyncLoadingMs) { asyncLoadingMs_.Set(asyncLoadingMs); }
+	void SetAutosaveInterval(float autosaveInterval) { autosaveInterval_.Set(autosaveInterval); }
 	void SetClient(bool client) { client_ = client; }
 	void SetGameName(const Urho3D::String& gameName) { gameName_ = gameName; }
+	void SetInterestRadius(float interestRadius) { interestRadius_.Set(interestRadius); }
+	void SetMaxPlayers(unsigned maxPlayers) { maxPlayers_.Set(maxPlayers); }
 	void SetPort(unsigned short port) { port_ = port; }
+	void SetTickRate(unsigned tickRate) { tickRate_.Set(tickRate); }
 
 	const Urho3D::String& GetAppName() const { return appName_; }
+	unsigned GetAsyncLoadingMs() const { return asyncLoadingMs_; }
+	float GetAutosaveInterval() const { return autosaveInterval_; }
 	const Urho3D::String& GetGameName() const { return gameName_; }
+	float GetInterestRadius() const { return interestRadius_; }
 	const Urho3D::String& GetProfileName() const { return profileName_; }
+	unsigned GetMaxPlayers() const { return maxPlayers_; }
 	unsigned short GetPort() const { return port_; }
+	unsigned GetTickRate() const { return tickRate_; }
 	bool IsClient() const { return client_; }
 
 private:
 	void CreatePath(const Urho3D::String& path) const;
 	Urho3D::String GetGameDataPath() const;
 	bool InitProfile();
+	bool LoadBinaryConfig(Urho3D::VariantMap& engineParameters, Urho3D::VariantMap& shellParameters);
 
 	Urho3D::String appName_;
 	Urho3D::String gameName_;
 	Urho3D::String profileName_;
 	Urho3D::String userDataPath_;
+	// Registered by CoreShell before this subsystem is created
+	ConfigParam<unsigned> asyncLoadingMs_;
+	ConfigParam<unsigned> maxPlayers_;
+	ConfigParam<unsigned> tickRate_;
+	ConfigParam<float> interestRadius_;
+	ConfigParam<float> autosaveInterval_; // Seconds, zero disables autosaves
+	unsigned schemaHash_;				   // Config parameters registered at startup
 	unsigned short port_;
 	bool client_;
 };
@@ -26,8 +26,10 @@
 #include <Urho3D/Math/StringHash.h>
 
 static Urho3D::StringHash SP_APP_NAME = "AppName";
+static Urho3D::StringHash SP_BOTS = "Bots";
 static Urho3D::StringHash SP_CLIENT = "Client";
 static Urho3D::StringHash SP_GAME_LIB = "GameLib";
+static Urho3D::StringHash SP_JOIN_TEST = "JoinTest";
 static Urho3D::StringHash SP_SERVER = "Server";
 static Urho3D::StringHash SP_SCENE = "Scene";
 static Urho3D::StringHash SP_SCRIPT = "Script";
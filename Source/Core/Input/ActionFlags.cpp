@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/IO/Deserializer.h>
+#include <Urho3D/IO/Serializer.h>
+#include "ActionFlags.h"
+
+using namespace Urho3D;
+
+void ActionFlags::Clear()
+{
+	for (unsigned& word : words_)
+		word = 0;
+}
+
+ActionFlags& ActionFlags::operator|=(const ActionFlags& rhs)
+{
+	for (unsigned i = 0; i < WORDS; ++i)
+		words_[i] |= rhs.words_[i];
+	return *this;
+}
+
+ActionFlags ActionFlags::operator^(const ActionFlags& rhs) const
+{
+	ActionFlags ret;
+	for (unsigned i = 0; i < WORDS; ++i)
+		ret.words_[i] = words_[i] ^ rhs.words_[i];
+	return ret;
+}
+
+bool ActionFlags::operator==(const ActionFlags& rhs) const
+{
+	for (unsigned i = 0; i < WORDS; ++i)
+		if (words_[i] != rhs.words_[i])
+			return false;
+	return true;
+}
+
+void ActionFlags::Write(Urho3D::Serializer& dest) const { WriteWords(dest, 0); }
+void ActionFlags::Read(Urho3D::Deserializer& source) { ReadWords(source, 0); }
+void ActionFlags::WriteExtended(Urho3D::Serializer& dest) const { WriteWords(dest, 1); }
+void ActionFlags::ReadExtended(Urho3D::Deserializer& source) { ReadWords(source, 1); }
+
+bool ActionFlags::HasExtended() const
+{
+	for (unsigned i = 1; i < WORDS; ++i)
+		if (words_[i])
+			return true;
+	return false;
+}
+
+void ActionFlags::WriteWords(Urho3D::Serializer& dest, unsigned first) const
+{
+	unsigned char mask = 0;
+	for (unsigned i = first; i < WORDS; ++i)
+		mask |= static_cast<unsigned char>((words_[i] != 0) << i);
+	dest.WriteUByte(mask);
+	for (unsigned i = first; i < WORDS; ++i)
+		if (words_[i])
+			dest.WriteUInt(words_[i]);
+}
+
+void ActionFlags::ReadWords(Urho3D::Deserializer& source, unsigned first)
+{
+	const unsigned char mask = source.IsEof() ? 0 : source.ReadUByte();
+	for (unsigned i = first; i < WORDS; ++i)
+		words_[i] = mask & (1u << i) ? source.ReadUInt() : 0;
+}
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef ACTIONFLAGS_H
+#define ACTIONFLAGS_H
+
+#include "U3SCoreAPI.h"
+
+namespace Urho3D
+{
+class Deserializer;
+class Serializer;
+} // namespace Urho3D
+
+// Remote action position in ActionFlags, precomputed for branchless tests
+struct ActionFlag
+{
+	unsigned word_;
+	unsigned mask_; // Zero if action is not remote
+
+	bool operator==(const ActionFlag& rhs) const { return word_ == rhs.word_ && mask_ == rhs.mask_; }
+	bool operator!=(const ActionFlag& rhs) const { return !(*this == rhs); }
+};
+
+class U3SCOREAPI_EXPORT ActionFlags
+{
+public:
+	static constexpr unsigned WORDS = 4;
+	static constexpr unsigned MAX_ACTIONS = WORDS * 32;
+
+	static ActionFlag GetFlag(unsigned index) { return {index / 32, 1u << (index % 32)}; }
+
+	void Set(ActionFlag flag, bool down) { words_[flag.word_] |= flag.mask_ * static_cast<unsigned>(down); }
+	void Reset(ActionFlag flag) { words_[flag.word_] &= ~flag.mask_; }
+	bool Test(ActionFlag flag) const { return words_[flag.word_] & flag.mask_; }
+	template <unsigned Index> bool Test() const
+	{
+		static_assert(Index < MAX_ACTIONS, "Action index is out of range");
+		return words_[Index / 32] & (1u << (Index % 32));
+	}
+	void Clear();
+
+	// First word is carried in Controls::buttons_
+	unsigned GetWord(unsigned word) const { return words_[word]; }
+	void SetWord(unsigned word, unsigned value) { words_[word] = value; }
+
+	ActionFlags& operator|=(const ActionFlags& rhs);
+	ActionFlags operator^(const ActionFlags& rhs) const;
+	bool operator==(const ActionFlags& rhs) const;
+	bool operator!=(const ActionFlags& rhs) const { return !(*this == rhs); }
+
+	// Bit-packed: mask of non-zero words followed by these words
+	void Write(Urho3D::Serializer& dest) const;
+	void Read(Urho3D::Deserializer& source);
+	void WriteExtended(Urho3D::Serializer& dest) const;
+	void ReadExtended(Urho3D::Deserializer& source);
+	bool HasExtended() const;
+
+private:
+	void WriteWords(Urho3D::Serializer& dest, unsigned first) const;
+	void ReadWords(Urho3D::Deserializer& source, unsigned first);
+
+	unsigned words_[WORDS]{};
+};
+
+#endif // ACTIONFLAGS_H
@@ -25,11 +25,10 @@
 
 using namespace Urho3D;
 
-static constexpr unsigned LAST_REMOTE_ACTION = 1 << 31;
-
 ActionsRegistry::ActionsRegistry(Urho3D::Context* context)
 	: Object(context)
-	, lastRemoteFlag_(1)
+	, remoteCount_(0)
+	, axesCount_(0)
 {
 }
 
@@ -39,23 +38,45 @@ void ActionsRegistry::RegisterLocal(const Urho3D::String& actionName)
 	names_[actionName] = actionName;
 }
 
-unsigned ActionsRegistry::RegisterRemote(const Urho3D::String& actionName)
+ActionFlag ActionsRegistry::RegisterRemote(const Urho3D::String& actionName)
 {
-	if (lastRemoteFlag_ < LAST_REMOTE_ACTION)
+	if (remoteCount_ < ActionFlags::MAX_ACTIONS)
 	{
 		const StringHash action = actionName;
-		const unsigned flag = lastRemoteFlag_;
+		const ActionFlag flag = ActionFlags::GetFlag(remoteCount_);
 		ordered_.Push(action);
 		names_[action] = actionName;
 		remoteFlags_[action] = flag;
-		lastRemoteFlag_ <<= 1;
+		++remoteCount_;
 		return flag;
 	}
 	else
 	{
-		URHO3D_LOGERRORF("Failed to register remote action %s: maximum allowed remote actions is 32.",
-						 actionName.CString());
-		return 0;
+		URHO3D_LOGERRORF("Failed to register remote action %s: maximum allowed remote actions is %u.",
+						 actionName.CString(),
+						 ActionFlags::MAX_ACTIONS);
+		return {0, 0};
+	}
+}
+
+ActionAxis ActionsRegistry::RegisterAxis(const Urho3D::String& actionName, bool precise)
+{
+	if (axesCount_ < InputFrame::MAX_AXES)
+	{
+		const StringHash action = actionName;
+		const ActionAxis axis{axesCount_, precise};
+		ordered_.Push(action);
+		names_[action] = actionName;
+		axes_[action] = axis;
+		++axesCount_;
+		return axis;
+	}
+	else
+	{
+		URHO3D_LOGERRORF("Failed to register axis action %s: maximum allowed axis actions is %u.",
+						 actionName.CString(),
+						 InputFrame::MAX_AXES);
+		return {InputFrame::MAX_AXES, false};
 	}
 }
 
@@ -66,6 +87,7 @@ void ActionsRegistry::Remove(Urho3D::StringHash action)
 		ordered_.Erase(it);
 	names_.Erase(action);
 	remoteFlags_.Erase(action);
+	axes_.Erase(action);
 }
 
 void ActionsRegistry::RemoveAll()
@@ -73,12 +95,21 @@ void ActionsRegistry::RemoveAll()
 	ordered_.Clear();
 	names_.Clear();
 	remoteFlags_.Clear();
+	axes_.Clear();
+	remoteCount_ = 0;
+	axesCount_ = 0;
 }
 
-unsigned ActionsRegistry::GetFlag(Urho3D::StringHash action) const
+ActionFlag ActionsRegistry::GetFlag(Urho3D::StringHash action) const
 {
 	const auto it = remoteFlags_.Find(action);
-	return it != remoteFlags_.End() ? it->second_ : 0;
+	return it != remoteFlags_.End() ? it->second_ : ActionFlag{0, 0};
+}
+
+ActionAxis ActionsRegistry::GetAxis(Urho3D::StringHash action) const
+{
+	const auto it = axes_.Find(action);
+	return it != axes_.End() ? it->second_ : ActionAxis{InputFrame::MAX_AXES, false};
 }
 
 const Urho3D::String& ActionsRegistry::GetName(Urho3D::StringHash action) const
@@ -90,18 +121,25 @@ const Urho3D::String& ActionsRegistry::GetName(Urho3D::StringHash action) const
 Urho3D::String ActionsRegistry::GetDebugString() const
 {
 	String ret;
-	Urho3D::HashMap<Urho3D::StringHash, unsigned>::ConstIterator it;
+	Urho3D::HashMap<Urho3D::StringHash, ActionFlag>::ConstIterator it;
+	Urho3D::HashMap<Urho3D::StringHash, ActionAxis>::ConstIterator itAxis;
 	for (const StringHash action : ordered_)
 	{
 		ret.Append("Name: ").Append(*names_[action]).Append("\n");
 		it = remoteFlags_.Find(action);
-		if (it == remoteFlags_.End())
-			ret.Append("\tType: Local\n");
-		else
+		itAxis = axes_.Find(action);
+		if (it != remoteFlags_.End())
 		{
 			ret.Append("\tType: Remote\n");
-			ret.Append(ToString("\tFlag: %u\n", it->second_));
+			ret.Append(ToString("\tFlag: %u:%08X\n", it->second_.word_, it->second_.mask_));
+		}
+		else if (itAxis != axes_.End())
+		{
+			ret.Append("\tType: Axis\n");
+			ret.Append(ToString("\tIndex: %u (%u bits)\n", itAxis->second_.index_, itAxis->second_.precise_ ? 16 : 8));
 		}
+		else
+			ret.Append("\tType: Local\n");
 	}
 	return ret;
 }
@@ -24,6 +24,8 @@
 #define ACTIONSREGISTRY_H
 
 #include <Urho3D/Core/Object.h>
+#include "ActionFlags.h"
+#include "InputFrame.h"
 #include "U3SCoreAPI.h"
 
 class U3SCOREAPI_EXPORT ActionsRegistry : public Urho3D::Object
@@ -36,22 +38,27 @@ public:
 	explicit ActionsRegistry(Urho3D::Context* context);
 
 	void RegisterLocal(const Urho3D::String& actionName);
-	unsigned RegisterRemote(const Urho3D::String& actionName);
+	ActionFlag RegisterRemote(const Urho3D::String& actionName);
+	ActionAxis RegisterAxis(const Urho3D::String& actionName, bool precise = false);
 	void Remove(Urho3D::StringHash action);
 	void RemoveAll();
 
-	unsigned GetFlag(Urho3D::StringHash action) const;
+	ActionFlag GetFlag(Urho3D::StringHash action) const;
+	ActionAxis GetAxis(Urho3D::StringHash action) const;
 	const Urho3D::String& GetName(Urho3D::StringHash action) const;
 	bool IsRemote(Urho3D::StringHash action) const { return remoteFlags_.Contains(action); }
+	bool IsAxis(Urho3D::StringHash action) const { return axes_.Contains(action); }
 	const ActionsVector& GetAll() const noexcept { return ordered_; }
 
 	Urho3D::String GetDebugString() const;
 
 private:
 	ActionsVector ordered_;
-	Urho3D::HashMap<Urho3D::StringHash, unsigned> remoteFlags_;
+	Urho3D::HashMap<Urho3D::StringHash, ActionFlag> remoteFlags_;
+	Urho3D::HashMap<Urho3D::StringHash, ActionAxis> axes_;
 	Urho3D::StringMap names_;
-	unsigned lastRemoteFlag_;
+	unsigned remoteCount_;
+	unsigned axesCount_;
 };
 
 #endif // ACTIONSREGISTRY_H
@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Input/Controls.h>
+#include <Urho3D/Math/MathDefs.h>
+#include "InputFrame.h"
+#include "Network/ServerDefs.h"
+
+#define AXIS_SCALE 32767.0f
+#define AXIS_SCALE_COARSE 127.0f
+#define AXIS_STEP_COARSE 256 // Coarse axis is sent as high byte only
+
+using namespace Urho3D;
+
+void InputFrame::AddAxis(ActionAxis axis, float value)
+{
+	if (axis.index_ >= MAX_AXES)
+		return;
+	float& sum = sums_[axis.index_];
+	sum += value;
+	value = Clamp(sum, -1.0f, 1.0f);
+	if (axis.precise_)
+		axes_[axis.index_] = static_cast<short>(RoundToInt(value * AXIS_SCALE));
+	else
+		axes_[axis.index_] = static_cast<short>(RoundToInt(value * AXIS_SCALE_COARSE) * AXIS_STEP_COARSE);
+}
+
+float InputFrame::GetAxis(ActionAxis axis) const
+{
+	if (axis.index_ >= MAX_AXES)
+		return 0.0f;
+	const float scale = axis.precise_ ? AXIS_SCALE : AXIS_SCALE_COARSE * AXIS_STEP_COARSE;
+	return Clamp(static_cast<float>(axes_[axis.index_]) / scale, -1.0f, 1.0f);
+}
+
+void InputFrame::ClearAxes()
+{
+	for (short& axis : axes_)
+		axis = 0;
+	for (float& sum : sums_)
+		sum = 0.0f;
+}
+
+bool InputFrame::HasAxes() const
+{
+	for (short axis : axes_)
+		if (axis)
+			return true;
+	return false;
+}
+
+void InputFrame::WriteAxes(Urho3D::Serializer& dest) const
+{
+	unsigned short used = 0;
+	unsigned short wide = 0;
+	for (unsigned i = 0; i < MAX_AXES; ++i)
+	{
+		used |= static_cast<unsigned short>((axes_[i] != 0) << i);
+		wide |= static_cast<unsigned short>(((axes_[i] & 0xff) != 0) << i);
+	}
+	dest.WriteUShort(used);
+	if (!used)
+		return;
+	dest.WriteUShort(wide);
+	for (unsigned i = 0; i < MAX_AXES; ++i)
+	{
+		if (wide & (1u << i))
+			dest.WriteShort(axes_[i]);
+		else if (used & (1u << i))
+			dest.WriteByte(static_cast<signed char>(axes_[i] >> 8));
+	}
+}
+
+void InputFrame::ReadAxes(Urho3D::Deserializer& source)
+{
+	const unsigned short used = source.IsEof() ? 0 : source.ReadUShort();
+	const unsigned short wide = used ? source.ReadUShort() : 0;
+	for (unsigned i = 0; i < MAX_AXES; ++i)
+	{
+		if (wide & (1u << i))
+		{
+			axes_[i] = source.ReadShort();
+			sums_[i] = static_cast<float>(axes_[i]) / AXIS_SCALE;
+		}
+		else if (used & (1u << i))
+		{
+			axes_[i] = static_cast<short>(source.ReadByte() * AXIS_STEP_COARSE);
+			sums_[i] = static_cast<float>(axes_[i]) / (AXIS_SCALE_COARSE * AXIS_STEP_COARSE);
+		}
+		else
+		{
+			axes_[i] = 0;
+			sums_[i] = 0.0f;
+		}
+	}
+}
+
+void InputFrame::ToControls(Urho3D::Controls& controls) const
+{
+	controls.buttons_ = actions_.GetWord(0);
+	controls.yaw_ = yaw_;
+	controls.pitch_ = pitch_;
+	controls.extraData_[CL_INPUT_SEQUENCE] = sequence_;
+	if (actions_.HasExtended())
+	{
+		VectorBuffer buffer;
+		actions_.WriteExtended(buffer);
+		controls.extraData_[CL_ACTIONS] = buffer.GetBuffer();
+	}
+	else
+		controls.extraData_.Erase(CL_ACTIONS);
+	if (HasAxes())
+	{
+		VectorBuffer buffer;
+		WriteAxes(buffer);
+		controls.extraData_[CL_AXES] = buffer.GetBuffer();
+	}
+	else
+		controls.extraData_.Erase(CL_AXES);
+}
+
+void InputFrame::FromControls(const Urho3D::Controls& controls)
+{
+	auto it = controls.extraData_.Find(CL_INPUT_SEQUENCE);
+	sequence_ = it != controls.extraData_.End() ? it->second_.GetUInt() : 0;
+	it = controls.extraData_.Find(CL_ACTIONS);
+	if (it != controls.extraData_.End())
+	{
+		MemoryBuffer buffer(it->second_.GetBuffer());
+		actions_.ReadExtended(buffer);
+	}
+	else
+		actions_.Clear();
+	actions_.SetWord(0, controls.buttons_);
+	it = controls.extraData_.Find(CL_AXES);
+	if (it != controls.extraData_.End())
+	{
+		MemoryBuffer buffer(it->second_.GetBuffer());
+		ReadAxes(buffer);
+	}
+	else
+		ClearAxes();
+	yaw_ = controls.yaw_;
+	pitch_ = controls.pitch_;
+}
+
+void InputFrame::WriteHistory(Urho3D::Serializer& dest,
+							  const Urho3D::PODVector<InputFrame>& frames,
+							  const InputFrame& newest)
+{
+	dest.WriteVLE(frames.Size());
+	const ActionFlags* next = &newest.actions_;
+	for (unsigned i = frames.Size(); i-- > 0;)
+	{
+		const InputFrame& frame = frames[i];
+		dest.WriteFloat(frame.yaw_);
+		dest.WriteFloat(frame.pitch_);
+		(frame.actions_ ^ *next).Write(dest);
+		frame.WriteAxes(dest);
+		next = &frame.actions_;
+	}
+}
+
+// Count comes from client, so it is bounded before allocating and checked against actual data
+bool InputFrame::ReadHistory(Urho3D::Deserializer& source,
+							 const InputFrame& newest,
+							 Urho3D::PODVector<InputFrame>& frames)
+{
+	const unsigned count = source.ReadVLE();
+	if (count > MAX_HISTORY)
+	{
+		frames.Clear();
+		return false;
+	}
+	frames.Resize(count);
+	ActionFlags next = newest.actions_;
+	for (unsigned i = count; i-- > 0;)
+	{
+		if (source.IsEof())
+		{
+			frames.Clear();
+			return false;
+		}
+		InputFrame& frame = frames[i];
+		frame.sequence_ = newest.sequence_ - (count - i);
+		frame.yaw_ = source.ReadFloat();
+		frame.pitch_ = source.ReadFloat();
+		frame.actions_.Read(source);
+		frame.actions_ = frame.actions_ ^ next;
+		frame.ReadAxes(source);
+		next = frame.actions_;
+	}
+	return true;
+}
@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef INPUTFRAME_H
+#define INPUTFRAME_H
+
+#include <Urho3D/Container/Vector.h>
+#include "ActionFlags.h"
+#include "U3SCoreAPI.h"
+
+namespace Urho3D
+{
+class Controls;
+}
+
+// Analog action slot in InputFrame
+struct ActionAxis
+{
+	unsigned index_; // MAX_AXES if action is not an axis
+	bool precise_;	 // 16 bits instead of 8 on the wire
+};
+
+// Input of one simulation tick
+struct U3SCOREAPI_EXPORT InputFrame
+{
+	static constexpr unsigned MAX_AXES = 16;
+	static constexpr unsigned MAX_HISTORY = 128; // Preceding frames sent in one packet at most
+
+	unsigned sequence_;
+	ActionFlags actions_;
+	short axes_[MAX_AXES]; // Quantized to [-32767, 32767], coarse ones in steps of 256
+	float sums_[MAX_AXES]; // Unquantized sums of added values, not sent
+	float yaw_;
+	float pitch_;
+
+	// Sum is clamped to [-1, 1] and quantized, so client and server see same value. Small values still add up.
+	void AddAxis(ActionAxis axis, float value);
+	float GetAxis(ActionAxis axis) const;
+	void ClearAxes();
+	bool HasAxes() const;
+
+	// Bit-packed: non-zero and 16-bit masks followed by axes values
+	void WriteAxes(Urho3D::Serializer& dest) const;
+	void ReadAxes(Urho3D::Deserializer& source);
+
+	// Network form: first actions word in buttons, the rest, axes and sequence in extra data
+	void ToControls(Urho3D::Controls& controls) const;
+	void FromControls(const Urho3D::Controls& controls);
+
+	// Preceding frames, newest first, actions as XOR delta against next newer frame. Reading fails on malformed
+	// data, frames are then empty.
+	static void WriteHistory(Urho3D::Serializer& dest,
+							 const Urho3D::PODVector<InputFrame>& frames,
+							 const InputFrame& newest);
+	static bool ReadHistory(Urho3D::Deserializer& source,
+							const InputFrame& newest,
+							Urho3D::PODVector<InputFrame>& frames);
+};
+
+#endif // INPUTFRAME_H
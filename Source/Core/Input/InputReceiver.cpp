@@ -21,36 +21,304 @@
 //
 
 #include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
 #include <Urho3D/Input/Controls.h>
+#include <Urho3D/Math/MathDefs.h>
 #include <Urho3D/Network/Connection.h>
 #include <Urho3D/Physics/PhysicsEvents.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Scene/Scene.h>
 #include "InputReceiver.h"
+#include "Network/NetworkStats.h"
+#include "Network/ServerDefs.h"
+
+#define JITTER_GAIN (1.0f / 16.0f)
 
 using namespace Urho3D;
 
 InputReceiver::InputReceiver(Urho3D::Context* context)
 	: Component(context)
-	, previous_(0)
+	, current_{}
+	, ackSequence_(0)
+	, jitter_(0.0f)
+	, packetFrames_(1.0f)
+	, receivedSequence_(0)
+	, targetDepth_(1)
+	, ticksSinceArrival_(0)
+	, underruns_(0)
+	, overruns_(0)
+	, lostFrames_(0)
+	, replayPosition_(0)
+	, replayTick_(0)
 	, connection_(nullptr)
+	, buffering_(true)
+	, predicted_(false)
+	, buffersDirty_(true)
 {
 }
 
 void InputReceiver::SetConnection(const Urho3D::Connection* connection)
 {
 	connection_ = connection;
-	SubscribeToEvent(E_PHYSICSPRESTEP, URHO3D_HANDLER(InputReceiver, OnPhysicsPreStep));
+	SubscribeToPhysics();
+}
+
+void InputReceiver::SetInput(const InputFrame& frame)
+{
+	previous_ = current_.actions_;
+	current_ = frame;
+	buffersDirty_ = true;
+}
+
+bool InputReceiver::StartReplay(const Urho3D::String& name)
+{
+	SharedPtr<InputRecording> recording(new InputRecording(context_));
+	if (!recording->Load(name) || recording->GetFrames().Empty())
+		return false;
+
+	if (!SubscribeToPhysics())
+		return false;
+	replay_ = recording;
+	replayPosition_ = 0;
+	replayTick_ = replay_->GetFrames().Front().sequence_ - 1;
+	return true;
+}
+
+void InputReceiver::StopReplay()
+{
+	if (!replay_)
+		return;
+	replay_.Reset();
+	current_.actions_.Clear();
+	current_.ClearAxes();
+	buffersDirty_ = true;
+	if (!connection_)
+		UnsubscribeFromEvent(E_PHYSICSPRESTEP);
 }
 
 void InputReceiver::OnPhysicsPreStep(Urho3D::StringHash, Urho3D::VariantMap&)
 {
-	previous_ = current_.buttons_;
-	current_ = connection_->GetControls();
+	// Fixed update of this step has already consumed current controls
+	ackSequence_ = current_.sequence_;
+	ackPosition_ = node_->GetPosition();
+	ackRotation_ = node_->GetRotation();
+
+	if (replay_)
+	{
+		ReplayFrame();
+		return;
+	}
+
+	const Controls& controls = connection_->GetControls();
+	if (!controls.extraData_.Contains(CL_INPUT_SEQUENCE))
+	{
+		InputFrame frame;
+		frame.FromControls(controls); // Client does not number inputs
+		SetInput(frame);
+		return;
+	}
+
+	++ticksSinceArrival_;
+	const unsigned lostFrames = lostFrames_;
+	const unsigned frames = ReceiveInput(controls);
+	if (frames)
+	{
+		UpdateJitter(frames);
+		ticksSinceArrival_ = 0;
+		GetSubsystem<NetworkStats>()->RecordInput(connection_, frames, lostFrames_ - lostFrames);
+	}
+	ReleaseFrame();
+}
+
+// Server and client scenes of local server both have physics, so only steps of own scene are handled
+bool InputReceiver::SubscribeToPhysics()
+{
+	Scene* scene = GetScene();
+	PhysicsWorld* physics = scene ? scene->GetComponent<PhysicsWorld>() : nullptr;
+	if (!physics)
+	{
+		URHO3D_LOGWARNING("Input receiver is not updated: scene has no physics world.");
+		return false;
+	}
+	SubscribeToEvent(physics, E_PHYSICSPRESTEP, URHO3D_HANDLER(InputReceiver, OnPhysicsPreStep));
+	return true;
+}
+
+void InputReceiver::UpdateJitter(unsigned frames)
+{
+	// Frames should arrive at tick rate, any deviation has to be absorbed by buffer
+	const float deviation = static_cast<float>(frames) - static_cast<float>(ticksSinceArrival_);
+	jitter_ += (Abs(deviation) - jitter_) * JITTER_GAIN;
+	packetFrames_ += (static_cast<float>(frames) - packetFrames_) * JITTER_GAIN;
+	targetDepth_ = Clamp(static_cast<unsigned>(CeilToInt(packetFrames_ + 2.0f * jitter_)), 1u, MAX_QUEUE / 2);
+}
+
+void InputReceiver::ReleaseFrame()
+{
+	previous_ = current_.actions_;
+	if (buffering_)
+	{
+		if (queue_.Size() < targetDepth_)
+			return; // Hold last controls until buffer is refilled
+		buffering_ = false;
+	}
+	if (queue_.Empty())
+	{
+		++underruns_;
+		buffering_ = true;
+		return;
+	}
+
+	// Too much latency accumulated: merge oldest frames so that presses are not lost
+	while (queue_.Size() > targetDepth_ * 2)
+	{
+		++overruns_;
+		queue_[1].actions_ |= queue_[0].actions_;
+		queue_.Erase(0);
+	}
+
+	current_ = queue_.Front();
+	queue_.Erase(0);
+	buffersDirty_ = true;
+}
+
+// Ticks without recorded frame hold last controls, same as when client sends nothing
+void InputReceiver::ReplayFrame()
+{
+	const PODVector<InputFrame>& frames = replay_->GetFrames();
+	if (replayPosition_ >= frames.Size())
+	{
+		URHO3D_LOGINFO("Input replay finished");
+		StopReplay();
+		return;
+	}
+
+	++replayTick_;
+	previous_ = current_.actions_;
+	if (frames[replayPosition_].sequence_ == replayTick_)
+	{
+		current_ = frames[replayPosition_++];
+		buffersDirty_ = true;
+	}
+}
+
+// Attributes are read for every connection on each network update, but input changes once per tick
+void InputReceiver::UpdateAttributeBuffers() const
+{
+	if (!buffersDirty_)
+		return;
+	actionsBuffer_.Clear();
+	current_.actions_.Write(actionsBuffer_);
+	axesBuffer_.Clear();
+	current_.WriteAxes(axesBuffer_);
+	buffersDirty_ = false;
+}
+
+// Packet carries newest frame in controls itself and preceding ones in redundancy buffer
+unsigned InputReceiver::ReceiveInput(const Urho3D::Controls& controls)
+{
+	InputFrame newest;
+	newest.FromControls(controls);
+	if (static_cast<int>(newest.sequence_ - receivedSequence_) <= 0)
+		return 0; // Same or reordered packet
+
+	unsigned frames = 0;
+	const auto it = controls.extraData_.Find(CL_INPUT_HISTORY);
+	if (it != controls.extraData_.End())
+	{
+		MemoryBuffer buffer(it->second_.GetBuffer());
+		if (InputFrame::ReadHistory(buffer, newest, history_))
+		{
+			for (const InputFrame& frame : history_)
+				frames += PushFrame(frame);
+		}
+	}
+	frames += PushFrame(newest);
+	return frames;
+}
+
+bool InputReceiver::PushFrame(const InputFrame& frame)
+{
+	if (static_cast<int>(frame.sequence_ - receivedSequence_) <= 0)
+		return false; // Already received in previous packet
+	if (receivedSequence_)
+		lostFrames_ += frame.sequence_ - receivedSequence_ - 1;
+	receivedSequence_ = frame.sequence_;
+	if (queue_.Size() >= MAX_QUEUE)
+	{
+		++overruns_;
+		queue_.Erase(0); // Keep latency bounded
+	}
+	queue_.Push(frame);
+	return true;
 }
 
 void InputReceiver::RegisterObject(Urho3D::Context* context)
 {
 	context->RegisterFactory<InputReceiver>("Input");
-	URHO3D_ATTRIBUTE("Controls", unsigned, current_.buttons_, 0, AM_NOEDIT | AM_LATESTDATA);
-	URHO3D_ATTRIBUTE("Pitch", float, current_.pitch_, 0, AM_NOEDIT | AM_LATESTDATA);
-	URHO3D_ATTRIBUTE("Yaw", float, current_.yaw_, 0, AM_NOEDIT | AM_LATESTDATA);
+	URHO3D_CUSTOM_ATTRIBUTE(
+		"Actions",
+		[](const InputReceiver& self, Variant& value)
+		{
+			self.UpdateAttributeBuffers();
+			value = self.actionsBuffer_.GetBuffer();
+		},
+		[](InputReceiver& self, const Variant& value)
+		{
+			if (!self.predicted_)
+			{
+				MemoryBuffer buffer(value.GetBuffer());
+				self.current_.actions_.Read(buffer);
+				self.buffersDirty_ = true;
+			}
+		},
+		PODVector<unsigned char>,
+		Variant::emptyBuffer,
+		AM_NET | AM_NOEDIT | AM_LATESTDATA);
+	URHO3D_CUSTOM_ATTRIBUTE(
+		"Axes",
+		[](const InputReceiver& self, Variant& value)
+		{
+			self.UpdateAttributeBuffers();
+			value = self.axesBuffer_.GetBuffer();
+		},
+		[](InputReceiver& self, const Variant& value)
+		{
+			if (!self.predicted_)
+			{
+				MemoryBuffer buffer(value.GetBuffer());
+				self.current_.ReadAxes(buffer);
+				self.buffersDirty_ = true;
+			}
+		},
+		PODVector<unsigned char>,
+		Variant::emptyBuffer,
+		AM_NET | AM_NOEDIT | AM_LATESTDATA);
+	URHO3D_CUSTOM_ATTRIBUTE(
+		"Pitch",
+		[](const InputReceiver& self, Variant& value) { value = self.current_.pitch_; },
+		[](InputReceiver& self, const Variant& value)
+		{
+			if (!self.predicted_)
+				self.current_.pitch_ = value.GetFloat();
+		},
+		float,
+		0,
+		AM_NET | AM_NOEDIT | AM_LATESTDATA);
+	URHO3D_CUSTOM_ATTRIBUTE(
+		"Yaw",
+		[](const InputReceiver& self, Variant& value) { value = self.current_.yaw_; },
+		[](InputReceiver& self, const Variant& value)
+		{
+			if (!self.predicted_)
+				self.current_.yaw_ = value.GetFloat();
+		},
+		float,
+		0,
+		AM_NET | AM_NOEDIT | AM_LATESTDATA);
+	URHO3D_ATTRIBUTE("Ack Sequence", unsigned, ackSequence_, 0, AM_NET | AM_NOEDIT | AM_LATESTDATA);
+	URHO3D_ATTRIBUTE("Ack Position", Vector3, ackPosition_, Vector3::ZERO, AM_NET | AM_NOEDIT | AM_LATESTDATA);
+	URHO3D_ATTRIBUTE(
+		"Ack Rotation", Quaternion, ackRotation_, Quaternion::IDENTITY, AM_NET | AM_NOEDIT | AM_LATESTDATA);
 }
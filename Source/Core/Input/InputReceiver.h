@@ -23,39 +23,108 @@
 #ifndef INPUTRECEIVER_H
 #define INPUTRECEIVER_H
 
-#include <Urho3D/Input/Controls.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Math/Quaternion.h>
+#include <Urho3D/Math/Vector3.h>
 #include <Urho3D/Scene/Component.h>
+#include "InputFrame.h"
+#include "InputRecording.h"
 #include "U3SCoreAPI.h"
 
 namespace Urho3D
 {
 class Connection;
-}
+class Controls;
+} // namespace Urho3D
 
 class U3SCOREAPI_EXPORT InputReceiver : public Urho3D::Component
 {
 	URHO3D_OBJECT(InputReceiver, Urho3D::Component)
 
 public:
+	static constexpr unsigned MAX_QUEUE = 16;
+
 	explicit InputReceiver(Urho3D::Context* context);
 
 	void SetConnection(const Urho3D::Connection* connection);
+	// Client side prediction: local controls override replicated ones
+	void SetPredicted(bool predicted) { predicted_ = predicted; }
+	void SetInput(const InputFrame& frame);
+	// Feed node from recording instead of connection, one recorded tick per physics step
+	bool StartReplay(const Urho3D::String& name);
+	void StopReplay();
 
-	bool IsDown(unsigned flag) const { return current_.buttons_ & flag; }
-	bool IsPressed(unsigned flag) const { return (current_.buttons_ & flag) && !(previous_ & flag); }
-	bool IsReleased(unsigned flag) const { return !(current_.buttons_ & flag) && (previous_ & flag); }
+	bool IsDown(ActionFlag flag) const { return current_.actions_.Test(flag); }
+	bool IsPressed(ActionFlag flag) const { return current_.actions_.Test(flag) && !previous_.Test(flag); }
+	bool IsReleased(ActionFlag flag) const { return !current_.actions_.Test(flag) && previous_.Test(flag); }
+	// Fast path for actions registered in known order
+	template <unsigned Index> bool IsDown() const { return current_.actions_.Test<Index>(); }
+	template <unsigned Index> bool IsPressed() const
+	{
+		return current_.actions_.Test<Index>() && !previous_.Test<Index>();
+	}
+	template <unsigned Index> bool IsReleased() const
+	{
+		return !current_.actions_.Test<Index>() && previous_.Test<Index>();
+	}
+	const ActionFlags& GetActions() const { return current_.actions_; }
+	float GetAxis(ActionAxis axis) const { return current_.GetAxis(axis); }
 	
 	float GetPitch() const { return current_.pitch_; }
 	float GetYaw() const { return current_.yaw_; }
+
+	// Last input applied to node and node transform right after it
+	unsigned GetAckSequence() const { return ackSequence_; }
+	const Urho3D::Vector3& GetAckPosition() const { return ackPosition_; }
+	const Urho3D::Quaternion& GetAckRotation() const { return ackRotation_; }
 	
+	// Jitter buffer state
+	unsigned GetBufferDepth() const { return queue_.Size(); }
+	unsigned GetTargetDepth() const { return targetDepth_; }
+	float GetJitter() const { return jitter_; }
+	unsigned GetUnderruns() const { return underruns_; }
+	unsigned GetOverruns() const { return overruns_; }
+	unsigned GetLostFrames() const { return lostFrames_; }
+
+	bool IsPredicted() const { return predicted_; }
+	bool IsReplaying() const { return replay_.NotNull(); }
 	bool IsServerSide() const { return connection_ != nullptr; }
 
 private:
 	void OnPhysicsPreStep(Urho3D::StringHash, Urho3D::VariantMap&);
 
-	Urho3D::Controls current_;
-	unsigned previous_;
+	bool SubscribeToPhysics();
+	unsigned ReceiveInput(const Urho3D::Controls& controls);
+	bool PushFrame(const InputFrame& frame);
+	void UpdateJitter(unsigned frames);
+	void ReleaseFrame();
+	void ReplayFrame();
+	void UpdateAttributeBuffers() const;
+
+	InputFrame current_;
+	ActionFlags previous_;
+	Urho3D::PODVector<InputFrame> queue_; // Received but not applied frames in sequence order
+	Urho3D::PODVector<InputFrame> history_;
+	Urho3D::SharedPtr<InputRecording> replay_;
+	mutable Urho3D::VectorBuffer actionsBuffer_; // Serialized current_ for replication
+	mutable Urho3D::VectorBuffer axesBuffer_;
+	Urho3D::Vector3 ackPosition_;
+	Urho3D::Quaternion ackRotation_;
+	float jitter_;		 // Mean deviation of received frames from elapsed ticks
+	float packetFrames_; // Average new frames per packet
+	unsigned ackSequence_;
+	unsigned receivedSequence_;
+	unsigned targetDepth_;
+	unsigned ticksSinceArrival_;
+	unsigned underruns_;
+	unsigned overruns_;
+	unsigned lostFrames_; // Skipped sequences, not covered by redundancy
+	unsigned replayPosition_; // Next recorded frame
+	unsigned replayTick_;
 	const Urho3D::Connection* connection_;
+	bool buffering_; // Refilling after underrun
+	bool predicted_;
+	mutable bool buffersDirty_; // current_ changed since attribute buffers were written
 
 public:
 	static void RegisterObject(Urho3D::Context* context);
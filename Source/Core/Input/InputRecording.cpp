@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include "Core/ShellConfigurator.h"
+#include "InputRecording.h"
+
+#define RECORDING_FILE_ID "U3IR"
+#define RECORDING_VERSION 1
+#define RECORDING_EXTENSION ".rec"
+#define MIN_RECORD_SIZE 12 // Tick delta, look angles, actions mask and axes mask
+
+using namespace Urho3D;
+
+InputRecording::InputRecording(Urho3D::Context* context)
+	: Object(context)
+	, last_{}
+{
+}
+
+InputRecording::~InputRecording() { StopRecording(); }
+
+bool InputRecording::StartRecording(const Urho3D::String& name)
+{
+	StopRecording();
+
+	const String filename = GetFilename(name);
+	SharedPtr<File> file(new File(context_));
+	if (!file->Open(filename, FILE_WRITE))
+	{
+		URHO3D_LOGERRORF("Failed to create input recording %s", filename.CString());
+		return false;
+	}
+	file->WriteFileID(RECORDING_FILE_ID);
+	file->WriteUShort(RECORDING_VERSION);
+	file_ = file;
+	last_ = InputFrame{};
+	URHO3D_LOGINFOF("Recording input to %s", filename.CString());
+	return true;
+}
+
+// Record: tick delta, look angles, actions as XOR delta against previous record and axes
+void InputRecording::Record(const InputFrame& frame)
+{
+	if (!file_)
+		return;
+
+	file_->WriteVLE(frame.sequence_ - last_.sequence_);
+	file_->WriteFloat(frame.yaw_);
+	file_->WriteFloat(frame.pitch_);
+	(frame.actions_ ^ last_.actions_).Write(*file_);
+	frame.WriteAxes(*file_);
+	last_ = frame;
+}
+
+void InputRecording::StopRecording()
+{
+	if (!file_)
+		return;
+	file_->Close();
+	file_.Reset();
+}
+
+bool InputRecording::Load(const Urho3D::String& name)
+{
+	frames_.Clear();
+
+	const String filename = GetFilename(name);
+	File file(context_);
+	if (!file.Open(filename, FILE_READ) || file.ReadFileID() != RECORDING_FILE_ID)
+	{
+		URHO3D_LOGERRORF("Failed to load input recording %s", filename.CString());
+		return false;
+	}
+	const unsigned version = file.ReadUShort();
+	if (version != RECORDING_VERSION)
+	{
+		URHO3D_LOGERRORF("Input recording %s has unsupported version %u", filename.CString(), version);
+		return false;
+	}
+
+	InputFrame frame{};
+	ActionFlags delta;
+	while (!file.IsEof())
+	{
+		// Record interrupted by exit or crash is dropped
+		if (file.GetSize() - file.GetPosition() < MIN_RECORD_SIZE)
+		{
+			URHO3D_LOGWARNINGF("Input recording %s is truncated", filename.CString());
+			break;
+		}
+		frame.sequence_ += file.ReadVLE();
+		frame.yaw_ = file.ReadFloat();
+		frame.pitch_ = file.ReadFloat();
+		delta.Read(file);
+		frame.actions_ = frame.actions_ ^ delta;
+		frame.ReadAxes(file);
+		frames_.Push(frame);
+	}
+	return true;
+}
+
+Urho3D::String InputRecording::GetFilename(const Urho3D::String& name) const
+{
+	if (IsAbsolutePath(name))
+		return name;
+	return GetSubsystem<ShellConfigurator>()->GetRecordingsPath() + name + RECORDING_EXTENSION;
+}
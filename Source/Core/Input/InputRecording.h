@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+#include <Urho3D/Core/Object.h>
+#include "InputFrame.h"
+#include "U3SCoreAPI.h"
+
+namespace Urho3D
+{
+class File;
+}
+
+// Per-tick input frames of one player stored in binary file in recordings path of user profile
+class U3SCOREAPI_EXPORT InputRecording : public Urho3D::Object
+{
+	URHO3D_OBJECT(InputRecording, Urho3D::Object)
+
+public:
+	explicit InputRecording(Urho3D::Context* context);
+	~InputRecording();
+
+	bool StartRecording(const Urho3D::String& name);
+	// Frames must come in increasing sequence order, sequence is used as tick number
+	void Record(const InputFrame& frame);
+	void StopRecording();
+
+	bool Load(const Urho3D::String& name);
+	const Urho3D::PODVector<InputFrame>& GetFrames() const noexcept { return frames_; }
+
+	bool IsRecording() const noexcept { return file_.NotNull(); }
+
+	Urho3D::String GetFilename(const Urho3D::String& name) const;
+
+private:
+	Urho3D::SharedPtr<Urho3D::File> file_;
+	Urho3D::PODVector<InputFrame> frames_;
+	InputFrame last_; // Delta base for next recorded frame
+};
+
+#endif // INPUTRECORDING_H
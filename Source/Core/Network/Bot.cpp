@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Math/Random.h>
+#include <Urho3D/Network/Connection.h>
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Network/NetworkEvents.h>
+#include <Urho3D/Scene/SceneEvents.h>
+#include "Bot.h"
+#include "Core/ShellConfigurator.h"
+#include "Input/ActionsRegistry.h"
+#include "ServerDefs.h"
+
+#define DEFAULT_INPUT_REDUNDANCY 3
+#define CYCLE_TICKS 30
+#define RANDOM_TICKS 10
+#define TURN_RATE 1.0f
+
+using namespace Urho3D;
+
+Bot::Bot(Urho3D::Context* context, unsigned index)
+	: Object(context)
+	, network_(new Network(context))
+	, scene_(context)
+	, input_{}
+	, tickStep_(1.0f / static_cast<float>(GetSubsystem<ShellConfigurator>()->GetTickRate()))
+	, tickTime_(0.0f)
+	, index_(index)
+	, sequence_(0)
+	, inputRedundancy_(DEFAULT_INPUT_REDUNDANCY)
+	, ticks_(0)
+	, step_(0)
+	, pattern_(PATTERN_CYCLE)
+	, sceneLoaded_(false)
+	, failed_(false)
+{
+	SubscribeToEvent(network_, E_SERVERCONNECTED, URHO3D_HANDLER(Bot, OnServerConnected));
+	SubscribeToEvent(network_, E_CONNECTFAILED, URHO3D_HANDLER(Bot, OnConnectFailed));
+}
+
+Bot::~Bot() { Disconnect(); }
+
+bool Bot::Connect(unsigned short port, const Urho3D::String& address)
+{
+	VariantMap identity;
+	identity[CL_NAME] = ToString("Bot%u", index_);
+	return network_->Connect(address, port, &scene_, identity);
+}
+
+void Bot::Disconnect()
+{
+	UnsubscribeFromEvent(E_UPDATE);
+	UnsubscribeFromEvent(network_, E_NETWORKUPDATE);
+	network_->Disconnect();
+}
+
+bool Bot::GetStats(Stats& stats) const
+{
+	const Connection* connection = network_->GetServerConnection();
+	if (!connection || !connection->IsConnected())
+		return false;
+	stats.roundTripTime_ = connection->GetRoundTripTime();
+	stats.bytesIn_ = connection->GetBytesInPerSec();
+	stats.bytesOut_ = connection->GetBytesOutPerSec();
+	return true;
+}
+
+bool Bot::IsConnected() const
+{
+	const Connection* connection = network_->GetServerConnection();
+	return connection && connection->IsConnected();
+}
+
+void Bot::OnServerConnected(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	SubscribeToEvent(&scene_, E_ASYNCLOADFINISHED, URHO3D_HANDLER(Bot, OnSceneLoaded));
+	SubscribeToEvent(network_->GetServerConnection(), E_NETWORKSCENELOADFAILED, URHO3D_HANDLER(Bot, OnSceneLoadFailed));
+}
+
+void Bot::OnConnectFailed(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	URHO3D_LOGWARNINGF("Bot %u failed to connect", index_);
+	failed_ = true;
+}
+
+void Bot::OnSceneLoaded(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	// Bot only feeds the server: replicated scene is kept without simulation
+	scene_.SetUpdateEnabled(false);
+	sceneLoaded_ = true;
+
+	const ActionsRegistry* actions = GetSubsystem<ActionsRegistry>();
+	flags_.Clear();
+	axes_.Clear();
+	for (StringHash action : actions->GetAll())
+	{
+		if (actions->IsRemote(action))
+			flags_.Push(actions->GetFlag(action));
+		else if (actions->IsAxis(action))
+			axes_.Push(actions->GetAxis(action));
+	}
+
+	SubscribeToEvent(E_UPDATE, URHO3D_HANDLER(Bot, OnUpdate));
+	SubscribeToEvent(network_, E_NETWORKUPDATE, URHO3D_HANDLER(Bot, OnNetworkUpdate));
+}
+
+void Bot::OnSceneLoadFailed(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	URHO3D_LOGWARNINGF("Bot %u failed to load scene %s", index_, scene_.GetFileName().CString());
+	failed_ = true;
+}
+
+// Frames are generated at server tick rate, same as client numbers them in physics steps
+void Bot::OnUpdate(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace Update;
+	tickTime_ += eventData[P_TIMESTEP].GetFloat();
+	while (tickTime_ >= tickStep_)
+	{
+		tickTime_ -= tickStep_;
+		GenerateInput();
+	}
+}
+
+void Bot::OnNetworkUpdate(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	Connection* connection = network_->GetServerConnection();
+	if (history_.Empty() || !connection)
+		return;
+
+	const InputFrame& newest = history_.Back();
+	newest.ToControls(controls_);
+	if (history_.Size() > 1)
+	{
+		resent_.Clear();
+		for (unsigned i = 0; i + 1 < history_.Size(); ++i)
+			resent_.Push(history_[i]);
+		VectorBuffer buffer;
+		InputFrame::WriteHistory(buffer, resent_, newest);
+		controls_.extraData_[CL_INPUT_HISTORY] = buffer.GetBuffer();
+	}
+	else
+		controls_.extraData_.Erase(CL_INPUT_HISTORY);
+	connection->SetControls(controls_);
+}
+
+void Bot::GenerateInput()
+{
+	++sequence_;
+	++ticks_;
+	input_.sequence_ = sequence_;
+	input_.actions_.Clear();
+	switch (pattern_)
+	{
+	case PATTERN_IDLE:
+		break;
+	case PATTERN_CYCLE:
+		if (ticks_ >= CYCLE_TICKS)
+		{
+			ticks_ = 0;
+			++step_;
+		}
+		if (!flags_.Empty())
+			input_.actions_.Set(flags_[step_ % flags_.Size()], true);
+		input_.yaw_ += TURN_RATE;
+		break;
+	case PATTERN_RANDOM:
+		if (ticks_ >= RANDOM_TICKS)
+		{
+			ticks_ = 0;
+			step_ = static_cast<unsigned>(Rand());
+			input_.ClearAxes();
+			for (ActionAxis axis : axes_)
+				input_.AddAxis(axis, Random(-1.0f, 1.0f));
+		}
+		for (unsigned i = 0; i < flags_.Size(); ++i)
+			input_.actions_.Set(flags_[i], (step_ >> (i % 16)) & 1u ? true : false);
+		input_.yaw_ += Random(-TURN_RATE, TURN_RATE) * 4.0f;
+		input_.pitch_ = Clamp(input_.pitch_ + Random(-TURN_RATE, TURN_RATE), -80.0f, 80.0f);
+		break;
+	}
+
+	history_.Push(input_);
+	if (history_.Size() > inputRedundancy_ + 1)
+		history_.Erase(0, history_.Size() - inputRedundancy_ - 1);
+}
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef BOT_H
+#define BOT_H
+
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Input/Controls.h>
+#include <Urho3D/Scene/Scene.h>
+#include "Input/InputFrame.h"
+#include "U3SCoreAPI.h"
+
+namespace Urho3D
+{
+class Connection;
+class Network;
+} // namespace Urho3D
+
+// Headless client for load testing: own network connection and replicated scene, synthetic input
+class U3SCOREAPI_EXPORT Bot : public Urho3D::Object
+{
+	URHO3D_OBJECT(Bot, Urho3D::Object)
+
+public:
+	enum Pattern
+	{
+		PATTERN_IDLE,	// Sends empty frames
+		PATTERN_CYCLE,	// Holds each remote action in turn
+		PATTERN_RANDOM, // Toggles random remote actions
+	};
+
+	struct Stats
+	{
+		float roundTripTime_; // ms
+		float bytesIn_;		  // Per second
+		float bytesOut_;	  // Per second
+	};
+
+	Bot(Urho3D::Context* context, unsigned index);
+	~Bot();
+
+	bool Connect(unsigned short port, const Urho3D::String& address = "localhost");
+	void Disconnect();
+
+	void SetPattern(Pattern pattern) noexcept { pattern_ = pattern; }
+	void SetInputRedundancy(unsigned redundancy) noexcept { inputRedundancy_ = redundancy; }
+
+	unsigned GetIndex() const noexcept { return index_; }
+	Pattern GetPattern() const noexcept { return pattern_; }
+	bool GetStats(Stats& stats) const;
+	bool IsConnected() const;
+	// Scene file name as sent by server, clients load it from own resources
+	const Urho3D::String& GetSceneName() const { return scene_.GetFileName(); }
+	bool IsSceneLoaded() const noexcept { return sceneLoaded_; }
+	bool IsFailed() const noexcept { return failed_; }
+
+private:
+	void OnServerConnected(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnConnectFailed(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnSceneLoaded(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnSceneLoadFailed(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnUpdate(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+	void OnNetworkUpdate(Urho3D::StringHash, Urho3D::VariantMap&);
+
+	void GenerateInput();
+
+	Urho3D::SharedPtr<Urho3D::Network> network_; // Network supports only one server connection
+	Urho3D::Scene scene_;
+	Urho3D::Controls controls_;
+	InputFrame input_;
+	Urho3D::PODVector<InputFrame> history_; // Sent frames, oldest first
+	Urho3D::PODVector<InputFrame> resent_;
+	Urho3D::PODVector<ActionFlag> flags_; // Remote actions to press
+	Urho3D::PODVector<ActionAxis> axes_;
+	float tickStep_;
+	float tickTime_; // Accumulated since last generated frame
+	unsigned index_;
+	unsigned sequence_;
+	unsigned inputRedundancy_;
+	unsigned ticks_; // Since current pattern step
+	unsigned step_;
+	Pattern pattern_;
+	bool sceneLoaded_;
+	bool failed_; // Connection or scene load failed
+};
+
+#endif // BOT_H
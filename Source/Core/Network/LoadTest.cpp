@@ -0,0 +1,170 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Network/Network.h>
+#include "LoadTest.h"
+#include "NetworkEvents.h"
+#include "Server.h"
+
+#define DEFAULT_REPORT_INTERVAL 10.0f
+#define BOTS_PER_FRAME 4
+
+using namespace Urho3D;
+
+LoadTest::LoadTest(Urho3D::Context* context)
+	: Object(context)
+	, server_(nullptr)
+	, reportInterval_(DEFAULT_REPORT_INTERVAL)
+	, reportTime_(0.0f)
+	, botsCount_(0)
+	, port_(0)
+	, pattern_(Bot::PATTERN_CYCLE)
+	, registeredEvents_(false)
+{
+}
+
+LoadTest::~LoadTest() { Stop(); }
+
+void LoadTest::Start(unsigned botsCount, unsigned short port, const Urho3D::String& address)
+{
+	Stop();
+	URHO3D_LOGINFOF("Starting load test: %u bots connecting to %s:%u", botsCount, address.CString(), port);
+	botsCount_ = botsCount;
+	port_ = port;
+	address_ = address;
+	reportTime_ = 0.0f;
+	bots_.Reserve(botsCount);
+
+	// Connections of bots check remote events against Network subsystem, not against own Network of bot
+	Network* network = GetSubsystem<Network>();
+	if (!network->CheckRemoteEvent(E_SERVERSIDESPAWNED))
+	{
+		network->RegisterRemoteEvent(E_SERVERSIDESPAWNED);
+		registeredEvents_ = true;
+	}
+	SubscribeToEvent(E_UPDATE, URHO3D_HANDLER(LoadTest, OnUpdate));
+}
+
+void LoadTest::Stop()
+{
+	UnsubscribeFromEvent(E_UPDATE);
+	bots_.Clear();
+	if (registeredEvents_)
+	{
+		GetSubsystem<Network>()->UnregisterRemoteEvent(E_SERVERSIDESPAWNED);
+		registeredEvents_ = false;
+	}
+}
+
+unsigned LoadTest::GetJoinedCount() const
+{
+	unsigned count = 0;
+	for (const SharedPtr<Bot>& bot : bots_)
+		if (bot->IsSceneLoaded() && (!server_ || bot->GetSceneName() == server_->GetSceneName()))
+			++count;
+	return count;
+}
+
+unsigned LoadTest::GetFailedCount() const
+{
+	unsigned count = 0;
+	for (const SharedPtr<Bot>& bot : bots_)
+		if (bot->IsFailed() || (bot->IsSceneLoaded() && server_ && bot->GetSceneName() != server_->GetSceneName()))
+			++count;
+	return count;
+}
+
+void LoadTest::OnUpdate(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace Update;
+
+	// Connect gradually, so that server is not flooded with simultaneous scene loads
+	for (unsigned i = 0; i < BOTS_PER_FRAME && bots_.Size() < botsCount_; ++i)
+	{
+		SharedPtr<Bot> bot(new Bot(context_, bots_.Size()));
+		bot->SetPattern(pattern_);
+		if (!bot->Connect(port_, address_))
+			URHO3D_LOGWARNINGF("Bot %u could not start connecting", bot->GetIndex());
+		bots_.Push(bot);
+	}
+
+	reportTime_ += eventData[P_TIMESTEP].GetFloat();
+	if (reportInterval_ > 0.0f && reportTime_ >= reportInterval_)
+	{
+		reportTime_ = 0.0f;
+		Report();
+	}
+}
+
+void LoadTest::Report() const
+{
+	Bot::Stats stats;
+	Bot::Stats total{};
+	float maxRoundTrip = 0.0f;
+	unsigned connected = 0;
+	for (const SharedPtr<Bot>& bot : bots_)
+	{
+		if (!bot->GetStats(stats))
+		{
+			URHO3D_LOGINFOF("Bot %u: not connected", bot->GetIndex());
+			continue;
+		}
+		URHO3D_LOGINFOF("Bot %u: rtt %.1f ms, in %.0f B/s, out %.0f B/s",
+						bot->GetIndex(),
+						stats.roundTripTime_,
+						stats.bytesIn_,
+						stats.bytesOut_);
+		total.roundTripTime_ += stats.roundTripTime_;
+		total.bytesIn_ += stats.bytesIn_;
+		total.bytesOut_ += stats.bytesOut_;
+		maxRoundTrip = Max(maxRoundTrip, stats.roundTripTime_);
+		++connected;
+	}
+	if (connected)
+		URHO3D_LOGINFOF("Bots connected %u/%u: avg rtt %.1f ms, max rtt %.1f ms, "
+						"total in %.0f B/s, total out %.0f B/s",
+						connected,
+						botsCount_,
+						total.roundTripTime_ / static_cast<float>(connected),
+						maxRoundTrip,
+						total.bytesIn_,
+						total.bytesOut_);
+
+	const unsigned count = server_ ? server_->GetTickStatsCount() : 0;
+	if (!count)
+		return;
+	float average = 0.0f;
+	float peak = 0.0f;
+	for (unsigned age = 0; age < count; ++age)
+	{
+		const float tickTime = server_->GetTickStats(age).total_;
+		average += tickTime;
+		peak = Max(peak, tickTime);
+	}
+	URHO3D_LOGINFOF("Server %u players: tick avg %.2f ms, max %.2f ms, overruns %u",
+					server_->GetPlayersCount(),
+					average / static_cast<float>(count),
+					peak,
+					server_->GetOverruns());
+}
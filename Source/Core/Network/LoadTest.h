@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef LOADTEST_H
+#define LOADTEST_H
+
+#include <Urho3D/Core/Object.h>
+#include "Bot.h"
+#include "U3SCoreAPI.h"
+
+class Server;
+
+// Connects bots to server in one process and periodically logs their network stats and server tick time
+class U3SCOREAPI_EXPORT LoadTest : public Urho3D::Object
+{
+	URHO3D_OBJECT(LoadTest, Urho3D::Object)
+
+public:
+	explicit LoadTest(Urho3D::Context* context);
+	~LoadTest();
+
+	// Server is optional, tick time is reported only for server running in this process
+	void Start(unsigned botsCount, unsigned short port, const Urho3D::String& address = "localhost");
+	void Stop();
+
+	void SetServer(const Server* server) noexcept { server_ = server; }
+	void SetPattern(Bot::Pattern pattern) noexcept { pattern_ = pattern; }
+	void SetReportInterval(float interval) noexcept { reportInterval_ = interval; }
+
+	unsigned GetBotsCount() const noexcept { return bots_.Size(); }
+	const Bot* GetBot(unsigned index) const { return index < bots_.Size() ? bots_[index].Get() : nullptr; }
+	// Joined bots loaded the scene by its resource name, failed ones could not connect or got another scene
+	unsigned GetJoinedCount() const;
+	unsigned GetFailedCount() const;
+
+private:
+	void OnUpdate(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+
+	void Report() const;
+
+	Urho3D::Vector<Urho3D::SharedPtr<Bot>> bots_;
+	Urho3D::String address_;
+	const Server* server_;
+	float reportInterval_;
+	float reportTime_; // Since last report
+	unsigned botsCount_;
+	unsigned short port_;
+	Bot::Pattern pattern_;
+	bool registeredEvents_; // Remote events bots accept were not registered by someone else
+};
+
+#endif // LOADTEST_H
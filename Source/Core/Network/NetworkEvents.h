@@ -29,6 +29,34 @@ URHO3D_EVENT(E_REMOTECLIENTSTARTED, RemoteClientStarted) {}
 URHO3D_EVENT(E_REMOTECLIENTSTOPPED, RemoteClientStopped) {}
 URHO3D_EVENT(E_REMOTESERVERSTARTED, RemoteServerStarted) {}
 URHO3D_EVENT(E_REMOTESERVERSTOPPED, RemoteServerStopped) {}
+URHO3D_EVENT(E_SCENERESTARTED, SceneRestarted) {}
+
+URHO3D_EVENT(E_GAMELOADED, GameLoaded)
+{
+	URHO3D_PARAM(P_STATE, State); // VariantMap, same as filled on saving
+}
+
+URHO3D_EVENT(E_GAMESAVED, GameSaved)
+{
+	URHO3D_PARAM(P_NAME, Name);		  // String
+	URHO3D_PARAM(P_SUCCESS, Success); // bool
+}
+
+URHO3D_EVENT(E_GAMESAVING, GameSaving)
+{
+	URHO3D_PARAM(P_NAME, Name);	  // String
+	URHO3D_PARAM(P_STATE, State); // VariantMap, plugins add own state to it
+}
+
+URHO3D_EVENT(E_SCENELOADPROGRESS, SceneLoadProgress)
+{
+	URHO3D_PARAM(P_PROGRESS, Progress);				  // float
+	URHO3D_PARAM(P_LOADEDNODES, LoadedNodes);		  // int
+	URHO3D_PARAM(P_TOTALNODES, TotalNodes);			  // int
+	URHO3D_PARAM(P_LOADEDRESOURCES, LoadedResources); // int
+	URHO3D_PARAM(P_TOTALRESOURCES, TotalResources);	  // int
+	URHO3D_PARAM(P_LOADEDBYTES, LoadedBytes);		  // unsigned long long
+}
 
 URHO3D_EVENT(E_SERVERSIDERESPAWNED, ServerSideRespawned)
 {
@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Engine/DebugHud.h>
+#include <Urho3D/Network/Connection.h>
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Network/NetworkEvents.h>
+#include "NetworkEvents.h"
+#include "NetworkStats.h"
+
+#define LOSS_GAIN (1.0f / 16.0f)
+#define MSG_INPUT "Input"
+
+using namespace Urho3D;
+
+NetworkStats::NetworkStats(Urho3D::Context* context)
+	: Object(context)
+	, sample_(0)
+	, debugHud_(false)
+{
+	names_[MSG_INPUT] = MSG_INPUT;
+	TrackRemoteEvent(E_SERVERSIDESPAWNED, "ServerSideSpawned");
+	TrackRemoteEvent(E_SERVERSIDERESPAWNED, "ServerSideRespawned");
+
+	Network* network = GetSubsystem<Network>();
+	SubscribeToEvent(network, E_NETWORKUPDATESENT, URHO3D_HANDLER(NetworkStats, OnNetworkUpdateSent));
+	SubscribeToEvent(network, E_NETWORKMESSAGE, URHO3D_HANDLER(NetworkStats, OnNetworkMessage));
+}
+
+void NetworkStats::TrackRemoteEvent(Urho3D::StringHash eventType, const Urho3D::String& name)
+{
+	names_[eventType] = name;
+	SubscribeToEvent(eventType, URHO3D_HANDLER(NetworkStats, OnRemoteEvent));
+}
+
+void NetworkStats::RecordMessage(const Urho3D::Connection* connection, Urho3D::StringHash type, unsigned count)
+{
+	GetEntry(connection).messages_[type] += count;
+}
+
+void NetworkStats::RecordInput(const Urho3D::Connection* connection, unsigned frames, unsigned lost)
+{
+	ConnectionStats& stats = GetEntry(connection);
+	stats.inputFrames_ += frames;
+	stats.lostFrames_ += lost;
+	stats.loss_ += (static_cast<float>(lost) / static_cast<float>(frames + lost) - stats.loss_) * LOSS_GAIN;
+	++stats.messages_[MSG_INPUT];
+}
+
+void NetworkStats::SetDebugHud(bool debugHud)
+{
+	if (debugHud_ && !debugHud)
+		for (auto it = connections_.Begin(); it != connections_.End(); ++it)
+			ResetDebugHud(it->second_);
+	debugHud_ = debugHud;
+}
+
+const NetworkStats::ConnectionStats* NetworkStats::GetStats(const Urho3D::Connection* connection) const
+{
+	const auto it = connections_.Find(connection);
+	return it != connections_.End() ? &it->second_ : nullptr;
+}
+
+unsigned NetworkStats::GetMessages(const Urho3D::Connection* connection, Urho3D::StringHash type) const
+{
+	const ConnectionStats* stats = GetStats(connection);
+	if (!stats)
+		return 0;
+	const auto it = stats->messages_.Find(type);
+	return it != stats->messages_.End() ? it->second_ : 0;
+}
+
+const Urho3D::String& NetworkStats::GetMessageName(Urho3D::StringHash type) const
+{
+	const auto it = names_.Find(type);
+	return it != names_.End() ? it->second_ : String::EMPTY;
+}
+
+void NetworkStats::OnNetworkUpdateSent(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	++sample_;
+	const Network* network = GetSubsystem<Network>();
+	if (network->IsServerRunning())
+	{
+		for (const SharedPtr<Connection>& connection : network->GetClientConnections())
+		{
+			ConnectionStats& stats = GetEntry(connection);
+			if (connection->IsSceneLoaded())
+				++stats.updateTicks_;
+			Sample(connection, stats);
+		}
+	}
+	const Connection* server = network->GetServerConnection();
+	if (server && server->IsConnected())
+	{
+		ConnectionStats& stats = GetEntry(server);
+		++stats.updateTicks_;
+		Sample(server, stats);
+	}
+
+	// Connections that were not sampled are gone, pointers must not be used anymore
+	for (auto it = connections_.Begin(); it != connections_.End();)
+		if (it->second_.sample_ != sample_)
+		{
+			if (debugHud_)
+				ResetDebugHud(it->second_);
+			it = connections_.Erase(it);
+		}
+		else
+			++it;
+}
+
+void NetworkStats::OnNetworkMessage(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace NetworkMessage;
+	const String name = ToString("Message%d", eventData[P_MESSAGEID].GetInt());
+	const StringHash type(name);
+	if (!names_.Contains(type))
+		names_[type] = name;
+	RecordMessage(static_cast<Connection*>(eventData[P_CONNECTION].GetPtr()), type);
+}
+
+void NetworkStats::OnRemoteEvent(Urho3D::StringHash eventType, Urho3D::VariantMap& eventData)
+{
+	using namespace ServerSideSpawned;
+	const Connection* connection = static_cast<Connection*>(eventData[P_CONNECTION].GetPtr());
+	if (connection)
+		RecordMessage(connection, eventType);
+}
+
+NetworkStats::ConnectionStats& NetworkStats::GetEntry(const Urho3D::Connection* connection)
+{
+	auto it = connections_.Find(connection);
+	if (it == connections_.End())
+	{
+		it = connections_.Insert(MakePair(connection, ConnectionStats{}));
+		it->second_.sample_ = sample_;
+		it->second_.name_ = "Net " + connection->ToString();
+	}
+	return it->second_;
+}
+
+void NetworkStats::Sample(const Urho3D::Connection* connection, ConnectionStats& stats)
+{
+	stats.bytesIn_ = connection->GetBytesInPerSec();
+	stats.bytesOut_ = connection->GetBytesOutPerSec();
+	stats.packetsIn_ = static_cast<float>(connection->GetPacketsInPerSec());
+	stats.packetsOut_ = static_cast<float>(connection->GetPacketsOutPerSec());
+	stats.roundTripTime_ = connection->GetRoundTripTime();
+	stats.sample_ = sample_;
+	if (debugHud_)
+		UpdateDebugHud(stats);
+}
+
+void NetworkStats::UpdateDebugHud(const ConnectionStats& stats) const
+{
+	DebugHud* debugHud = GetSubsystem<DebugHud>();
+	if (!debugHud)
+		return;
+	debugHud->SetAppStats(stats.name_,
+						  ToString("rtt %.0f ms, in %.0f B/s (%.0f/s), out %.0f B/s (%.0f/s), loss %.1f%%",
+								   stats.roundTripTime_,
+								   stats.bytesIn_,
+								   stats.packetsIn_,
+								   stats.bytesOut_,
+								   stats.packetsOut_,
+								   stats.loss_ * 100.0f));
+}
+
+void NetworkStats::ResetDebugHud(const ConnectionStats& stats) const
+{
+	DebugHud* debugHud = GetSubsystem<DebugHud>();
+	if (debugHud)
+		debugHud->ResetAppStats(stats.name_);
+}
@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef NETWORKSTATS_H
+#define NETWORKSTATS_H
+
+#include <Urho3D/Core/Object.h>
+#include "U3SCoreAPI.h"
+
+namespace Urho3D
+{
+class Connection;
+}
+
+// Per connection traffic, latency, input loss and counts of messages visible above Urho3D network layer
+class U3SCOREAPI_EXPORT NetworkStats : public Urho3D::Object
+{
+	URHO3D_OBJECT(NetworkStats, Urho3D::Object)
+
+public:
+	struct ConnectionStats
+	{
+		float bytesIn_;		  // Per second
+		float bytesOut_;	  // Per second
+		float packetsIn_;	  // Per second
+		float packetsOut_;	  // Per second
+		float roundTripTime_; // ms
+		float loss_;		  // Smoothed fraction of input frames never received, server side only
+		unsigned inputFrames_;
+		unsigned lostFrames_;
+		unsigned updateTicks_; // Network updates since connection, not a message count
+		unsigned sample_;	  // Network update of last sample, stale entries are removed
+		Urho3D::String name_; // Connection address for debug HUD, it may outlive connection
+		Urho3D::HashMap<Urho3D::StringHash, unsigned> messages_; // Type -> Count since connection
+	};
+
+	explicit NetworkStats(Urho3D::Context* context);
+
+	// Count remote event with connection parameter, sent or received
+	void TrackRemoteEvent(Urho3D::StringHash eventType, const Urho3D::String& name);
+	void RecordMessage(const Urho3D::Connection* connection, Urho3D::StringHash type, unsigned count = 1);
+	void RecordInput(const Urho3D::Connection* connection, unsigned frames, unsigned lost);
+
+	void SetDebugHud(bool debugHud);
+
+	const ConnectionStats* GetStats(const Urho3D::Connection* connection) const;
+	unsigned GetMessages(const Urho3D::Connection* connection, Urho3D::StringHash type) const;
+	const Urho3D::String& GetMessageName(Urho3D::StringHash type) const;
+	bool IsDebugHud() const noexcept { return debugHud_; }
+
+private:
+	void OnNetworkUpdateSent(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnNetworkMessage(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+	void OnRemoteEvent(Urho3D::StringHash eventType, Urho3D::VariantMap& eventData);
+
+	ConnectionStats& GetEntry(const Urho3D::Connection* connection);
+	void Sample(const Urho3D::Connection* connection, ConnectionStats& stats);
+	void UpdateDebugHud(const ConnectionStats& stats) const;
+	void ResetDebugHud(const ConnectionStats& stats) const;
+
+	Urho3D::HashMap<const Urho3D::Connection*, ConnectionStats> connections_;
+	Urho3D::HashMap<Urho3D::StringHash, Urho3D::String> names_; // Message type -> Name
+	unsigned sample_;
+	bool debugHud_;
+};
+
+#endif // NETWORKSTATS_H
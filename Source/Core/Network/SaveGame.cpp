@@ -0,0 +1,438 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Graphics/Graphics.h>
+#include <Urho3D/IO/Compression.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Resource/XMLFile.h>
+#include <Urho3D/Scene/Scene.h>
+#include "Core/ShellConfigurator.h"
+#include "NetworkEvents.h"
+#include "SaveGame.h"
+#include "SceneDelta.h"
+
+#define SAVE_FILE_ID "U3SG"
+#define SAVE_VERSION 1
+#define SAVE_EXTENSION ".sav"
+#define DELTA_FILE_ID "U3SD"
+#define DELTA_EXTENSION ".dlt"
+#define THUMBNAIL_EXTENSION ".png"
+#define TEMP_EXTENSION ".tmp"
+#define INDEX_FILENAME "Saves.xml"
+#define INDEX_ROOT "saves"
+#define BLOCK_SIZE 65536
+#define THUMBNAIL_WIDTH 160
+#define THUMBNAIL_HEIGHT 90
+
+using namespace Urho3D;
+
+struct SaveGame::Job
+{
+	Context* context_;
+	Info info_;
+	VectorBuffer scene_;
+	VariantMap state_;
+	SharedPtr<Image> thumbnail_;
+	bool delta_;  // Scene holds changes to be appended to delta file of existing save
+	bool append_; // Delta file exists already
+	bool success_;
+};
+
+SaveGame::SaveGame(Urho3D::Context* context)
+	: Object(context)
+{
+	SubscribeToEvent(E_WORKITEMCOMPLETED, URHO3D_HANDLER(SaveGame, OnWorkItemCompleted));
+}
+
+SaveGame::~SaveGame()
+{
+	// Do not lose save requested right before exit
+	if (job_)
+		GetSubsystem<WorkQueue>()->Complete(0);
+}
+
+bool SaveGame::Save(const Urho3D::String& name,
+					const Urho3D::Scene& scene,
+					const Urho3D::String& sceneName,
+					bool thumbnail)
+{
+	if (job_)
+	{
+		URHO3D_LOGWARNINGF("Failed to save game %s: previous save is still being written", name.CString());
+		return false;
+	}
+
+	UniquePtr<Job> job(new Job{});
+	job->context_ = context_;
+	job->info_.name_ = name;
+	job->info_.scene_ = sceneName;
+	job->info_.date_ = Time::GetTimeStamp();
+	job->info_.filename_ = GetSaveFilename(name);
+
+	// Only in-memory serialization happens on main thread, compression and disk access are left to worker
+	if (!scene.Save(job->scene_))
+	{
+		URHO3D_LOGERRORF("Failed to save game %s: scene serialization failed", name.CString());
+		return false;
+	}
+
+	CollectState(name, job->state_);
+
+	Graphics* graphics = GetSubsystem<Graphics>();
+	if (thumbnail && graphics && graphics->IsInitialized())
+	{
+		job->thumbnail_ = MakeShared<Image>(context_);
+		if (graphics->TakeScreenShot(*job->thumbnail_))
+			job->info_.thumbnail_ = ReplaceExtension(job->info_.filename_, THUMBNAIL_EXTENSION);
+		else
+			job->thumbnail_.Reset();
+	}
+
+	Queue(std::move(job));
+	return true;
+}
+
+bool SaveGame::SaveDelta(const Urho3D::String& name, SceneDelta& delta)
+{
+	if (job_)
+	{
+		URHO3D_LOGWARNINGF("Failed to save game %s: previous save is still being written", name.CString());
+		return false;
+	}
+
+	UniquePtr<Job> job(new Job{});
+	for (const Info& info : GetSaves())
+		if (info.name_ == name)
+			job->info_ = info;
+	if (job->info_.name_.Empty())
+	{
+		URHO3D_LOGWARNINGF("Failed to save changes of game %s: there is no full save to apply them to", name.CString());
+		return false;
+	}
+
+	job->context_ = context_;
+	job->delta_ = true;
+	job->append_ = GetSubsystem<FileSystem>()->FileExists(ReplaceExtension(job->info_.filename_, DELTA_EXTENSION));
+	if (!delta.Write(job->scene_))
+	{
+		URHO3D_LOGERRORF("Failed to save changes of game %s: scene serialization failed", name.CString());
+		return false;
+	}
+	CollectState(name, job->state_);
+	Queue(std::move(job));
+	return true;
+}
+
+bool SaveGame::Extract(const Urho3D::String& filename,
+					   const Urho3D::String& sceneFilename,
+					   Urho3D::String& sceneName,
+					   Urho3D::VariantMap& state) const
+{
+	File source(context_, filename);
+	if (!source.IsOpen())
+		return false;
+	if (source.ReadFileID() != SAVE_FILE_ID || source.ReadUShort() != SAVE_VERSION)
+	{
+		URHO3D_LOGERRORF("Failed to load game %s: unsupported file format", filename.CString());
+		return false;
+	}
+	source.ReadString(); // Name
+	sceneName = source.ReadString();
+	source.ReadString(); // Date
+	state = source.ReadVariantMap();
+
+	File dest(context_, sceneFilename, FILE_WRITE);
+	if (!dest.IsOpen())
+		return false;
+	while (!source.IsEof())
+		if (!DecompressStream(dest, source))
+		{
+			URHO3D_LOGERRORF("Failed to load game %s: file is broken", filename.CString());
+			return false;
+		}
+	return true;
+}
+
+// Segments are replayed in order, incomplete one left by interrupted write is dropped
+bool SaveGame::ApplyDeltas(const Urho3D::String& filename, Urho3D::Scene& scene, Urho3D::VariantMap& state) const
+{
+	const String deltaFilename = ReplaceExtension(filename, DELTA_EXTENSION);
+	if (!GetSubsystem<FileSystem>()->FileExists(deltaFilename))
+		return true;
+
+	File base(context_, filename);
+	base.ReadFileID();
+	base.ReadUShort();
+	base.ReadString(); // Name
+	base.ReadString(); // Scene
+	File source(context_, deltaFilename);
+	if (source.ReadFileID() != DELTA_FILE_ID || source.ReadUShort() != SAVE_VERSION ||
+		source.ReadString() != base.ReadString())
+	{
+		URHO3D_LOGWARNINGF("Changes of game %s skipped: they belong to different save", filename.CString());
+		return false;
+	}
+
+	VectorBuffer segment;
+	unsigned segments = 0;
+	while (!source.IsEof())
+	{
+		segment.Clear();
+		if (!DecompressStream(segment, source))
+		{
+			URHO3D_LOGWARNINGF("Last changes of game %s are incomplete and skipped", filename.CString());
+			break;
+		}
+		segment.Seek(0);
+		state = segment.ReadVariantMap();
+		if (!SceneDelta::Apply(scene, segment))
+		{
+			URHO3D_LOGERRORF("Failed to apply changes of game %s", filename.CString());
+			return false;
+		}
+		++segments;
+	}
+	URHO3D_LOGDEBUGF("Applied %u change segments of game %s", segments, filename.CString());
+	return true;
+}
+
+void SaveGame::Remove(const Urho3D::String& name)
+{
+	FileSystem* fileSystem = GetSubsystem<FileSystem>();
+	Vector<Info> saves = GetSaves();
+	for (auto it = saves.Begin(); it != saves.End();)
+		if (it->name_ == name)
+		{
+			fileSystem->Delete(it->filename_);
+			fileSystem->Delete(ReplaceExtension(it->filename_, DELTA_EXTENSION));
+			if (!it->thumbnail_.Empty())
+				fileSystem->Delete(it->thumbnail_);
+			it = saves.Erase(it);
+		}
+		else
+			++it;
+	SaveIndex(saves);
+}
+
+Urho3D::Vector<SaveGame::Info> SaveGame::GetSaves() const
+{
+	Vector<Info> saves;
+	const String filename = GetIndexFilename();
+	XMLFile file(context_);
+	if (!GetSubsystem<FileSystem>()->FileExists(filename) || !file.LoadFile(filename))
+		return saves;
+
+	// File names are kept relative, so that profile may be moved
+	const String path = GetSubsystem<ShellConfigurator>()->GetSavesPath();
+	Info info;
+	for (XMLElement save = file.GetRoot(INDEX_ROOT).GetChild("save"); !save.IsNull(); save = save.GetNext("save"))
+	{
+		info.name_ = save.GetAttribute("name");
+		info.scene_ = save.GetAttribute("scene");
+		info.date_ = save.GetAttribute("date");
+		info.filename_ = path + save.GetAttribute("file");
+		info.thumbnail_ = save.HasAttribute("thumbnail") ? path + save.GetAttribute("thumbnail") : String::EMPTY;
+		saves.Push(info);
+	}
+	return saves;
+}
+
+bool SaveGame::IsSaveFile(const Urho3D::String& filename) { return filename.EndsWith(SAVE_EXTENSION, false); }
+
+void SaveGame::SaveIndex(const Urho3D::Vector<Info>& saves) const
+{
+	XMLFile file(context_);
+	XMLElement root = file.CreateRoot(INDEX_ROOT);
+	XMLElement save;
+	for (const Info& info : saves)
+	{
+		save = root.CreateChild("save");
+		save.SetAttribute("name", info.name_);
+		save.SetAttribute("scene", info.scene_);
+		save.SetAttribute("date", info.date_);
+		save.SetAttribute("file", GetFileNameAndExtension(info.filename_));
+		if (!info.thumbnail_.Empty())
+			save.SetAttribute("thumbnail", GetFileNameAndExtension(info.thumbnail_));
+	}
+	file.SaveFile(GetIndexFilename());
+}
+
+void SaveGame::CollectState(const Urho3D::String& name, Urho3D::VariantMap& state)
+{
+	using namespace GameSaving;
+	VariantMap& eventData = GetEventDataMap();
+	eventData[P_NAME] = name;
+	eventData[P_STATE] = VariantMap();
+	SendEvent(E_GAMESAVING, eventData);
+	state = eventData[P_STATE].GetVariantMap();
+}
+
+void SaveGame::Queue(Urho3D::UniquePtr<Job> job)
+{
+	WorkQueue* queue = GetSubsystem<WorkQueue>();
+	work_ = queue->GetFreeItem();
+	work_->priority_ = 0;
+	work_->workFunction_ = WriteSave;
+	work_->aux_ = job.Get();
+	work_->sendEvent_ = true;
+	job_ = std::move(job);
+	queue->AddWorkItem(work_);
+}
+
+Urho3D::String SaveGame::GetIndexFilename() const
+{
+	return GetSubsystem<ShellConfigurator>()->GetSavesPath() + INDEX_FILENAME;
+}
+
+Urho3D::String SaveGame::GetSaveFilename(const Urho3D::String& name) const
+{
+	String filename = name;
+	for (const char* c = "\\/:*?\"<>|"; *c; ++c)
+		filename.Replace(*c, '_');
+	return GetSubsystem<ShellConfigurator>()->GetSavesPath() + filename + SAVE_EXTENSION;
+}
+
+// Files are written under temporary names and replace previous save only when complete
+void SaveGame::OnWorkItemCompleted(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace WorkItemCompleted;
+	if (!job_ || eventData[P_ITEM].GetPtr() != work_.Get())
+		return;
+
+	const Info& info = job_->info_;
+	FileSystem* fileSystem = GetSubsystem<FileSystem>();
+	if (job_->delta_)
+	{
+		if (!job_->success_)
+			URHO3D_LOGERRORF("Failed to save changes of game %s", info.name_.CString());
+	}
+	else if (job_->success_)
+	{
+		// Changes made on top of previous save are included into new one
+		fileSystem->Delete(ReplaceExtension(info.filename_, DELTA_EXTENSION));
+		fileSystem->Delete(info.filename_);
+		fileSystem->Rename(info.filename_ + TEMP_EXTENSION, info.filename_);
+		if (!info.thumbnail_.Empty())
+		{
+			fileSystem->Delete(info.thumbnail_);
+			fileSystem->Rename(info.thumbnail_ + TEMP_EXTENSION, info.thumbnail_);
+		}
+
+		Vector<Info> saves = GetSaves();
+		for (auto it = saves.Begin(); it != saves.End();)
+			if (it->name_ == info.name_)
+				it = saves.Erase(it);
+			else
+				++it;
+		saves.Insert(0, info); // Newest first
+		SaveIndex(saves);
+		URHO3D_LOGINFOF("Game saved to %s", info.filename_.CString());
+	}
+	else
+	{
+		fileSystem->Delete(info.filename_ + TEMP_EXTENSION);
+		URHO3D_LOGERRORF("Failed to save game %s: could not write %s", info.name_.CString(), info.filename_.CString());
+	}
+
+	using namespace GameSaved;
+	VariantMap& savedData = GetEventDataMap();
+	savedData[P_NAME] = info.name_;
+	savedData[P_SUCCESS] = job_->success_;
+	job_.Reset();
+	work_.Reset();
+	SendEvent(E_GAMESAVED, savedData);
+}
+
+// Worker thread: touches nothing but the job
+void SaveGame::WriteSave(const Urho3D::WorkItem* item, unsigned)
+{
+	Job* job = static_cast<Job*>(item->aux_);
+	if (job->delta_)
+	{
+		WriteDelta(job);
+		return;
+	}
+	const Info& info = job->info_;
+
+	File file(job->context_, info.filename_ + TEMP_EXTENSION, FILE_WRITE);
+	job->success_ = file.IsOpen();
+	if (!job->success_)
+		return;
+
+	file.WriteFileID(SAVE_FILE_ID);
+	file.WriteUShort(SAVE_VERSION);
+	file.WriteString(info.name_);
+	file.WriteString(info.scene_);
+	file.WriteString(info.date_);
+	file.WriteVariantMap(job->state_);
+
+	// Independent blocks let loading decompress scene without holding it in memory as a whole
+	const unsigned char* data = job->scene_.GetData();
+	const unsigned size = job->scene_.GetSize();
+	for (unsigned offset = 0; offset < size && job->success_; offset += BLOCK_SIZE)
+	{
+		MemoryBuffer block(data + offset, Min(size - offset, static_cast<unsigned>(BLOCK_SIZE)));
+		job->success_ = CompressStream(file, block);
+	}
+	file.Close();
+
+	if (job->thumbnail_ && job->success_)
+	{
+		job->thumbnail_->Resize(THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT);
+		job->thumbnail_->SavePNG(info.thumbnail_ + TEMP_EXTENSION);
+	}
+}
+
+// Delta file is appended in place: segment is self-sized, so incomplete tail is detected on load
+void SaveGame::WriteDelta(Job* job)
+{
+	const String filename = ReplaceExtension(job->info_.filename_, DELTA_EXTENSION);
+	File file(job->context_);
+	if (job->append_)
+	{
+		job->success_ = file.Open(filename, FILE_READWRITE);
+		file.Seek(file.GetSize());
+	}
+	else
+	{
+		// Base save date tells which save these changes belong to
+		job->success_ = file.Open(filename, FILE_WRITE);
+		file.WriteFileID(DELTA_FILE_ID);
+		file.WriteUShort(SAVE_VERSION);
+		file.WriteString(job->info_.date_);
+	}
+	if (!job->success_)
+		return;
+
+	VectorBuffer segment;
+	segment.WriteVariantMap(job->state_);
+	segment.Write(job->scene_.GetData(), job->scene_.GetSize());
+	segment.Seek(0);
+	job->success_ = CompressStream(file, segment);
+}
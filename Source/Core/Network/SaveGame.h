@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef SAVEGAME_H
+#define SAVEGAME_H
+
+#include <Urho3D/Container/Ptr.h>
+#include <Urho3D/Core/Object.h>
+#include "U3SCoreAPI.h"
+
+namespace Urho3D
+{
+class Scene;
+class WorkItem;
+} // namespace Urho3D
+
+class SceneDelta;
+
+// Saved games in saves path of user profile. Scene is serialized on main thread and written on worker thread.
+class U3SCOREAPI_EXPORT SaveGame : public Urho3D::Object
+{
+	URHO3D_OBJECT(SaveGame, Urho3D::Object)
+
+public:
+	struct Info
+	{
+		Urho3D::String name_;
+		Urho3D::String scene_;	   // Scene resource the game was started from
+		Urho3D::String date_;
+		Urho3D::String filename_;  // Absolute
+		Urho3D::String thumbnail_; // Absolute, empty if no screenshot taken
+	};
+
+	explicit SaveGame(Urho3D::Context* context);
+	~SaveGame();
+
+	// Thumbnail is full framebuffer readback on main thread, so autosaves go without it
+	bool Save(const Urho3D::String& name,
+			  const Urho3D::Scene& scene,
+			  const Urho3D::String& sceneName,
+			  bool thumbnail = true);
+	// Appends changes since previous full save or delta to existing save with the same name
+	bool SaveDelta(const Urho3D::String& name, SceneDelta& delta);
+	// Unpacks scene to separate file, so that it may be loaded asynchronously
+	bool Extract(const Urho3D::String& filename,
+				 const Urho3D::String& sceneFilename,
+				 Urho3D::String& sceneName,
+				 Urho3D::VariantMap& state) const;
+	// Replays changes saved after full save on top of its loaded scene
+	bool ApplyDeltas(const Urho3D::String& filename, Urho3D::Scene& scene, Urho3D::VariantMap& state) const;
+	void Remove(const Urho3D::String& name);
+
+	// Reads index only, save files are not opened
+	Urho3D::Vector<Info> GetSaves() const;
+	bool IsSaving() const noexcept { return job_.NotNull(); }
+
+	static bool IsSaveFile(const Urho3D::String& filename);
+
+private:
+	struct Job;
+
+	void CollectState(const Urho3D::String& name, Urho3D::VariantMap& state);
+	void Queue(Urho3D::UniquePtr<Job> job);
+	void SaveIndex(const Urho3D::Vector<Info>& saves) const;
+	Urho3D::String GetIndexFilename() const;
+	Urho3D::String GetSaveFilename(const Urho3D::String& name) const;
+
+	void OnWorkItemCompleted(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+
+	static void WriteSave(const Urho3D::WorkItem* item, unsigned threadIndex);
+	static void WriteDelta(Job* job);
+
+	Urho3D::UniquePtr<Job> job_; // Save in progress
+	Urho3D::SharedPtr<Urho3D::WorkItem> work_;
+};
+
+#endif // SAVEGAME_H
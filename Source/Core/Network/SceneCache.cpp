@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+#include "Core/ShellConfigurator.h"
+#include "SceneCache.h"
+#include "SceneSource.h"
+
+#define CACHE_FILE_ID "U3SC"
+#define CACHE_VERSION 2
+#define SCENE_EXTENSION ".bin"
+#define HEADER_EXTENSION ".hdr"
+
+using namespace Urho3D;
+
+SceneCache::SceneCache(Urho3D::Context* context)
+	: Object(context)
+{
+}
+
+Urho3D::SharedPtr<Urho3D::File> SceneCache::GetCachedFile(const Urho3D::String& sceneName) const
+{
+	if (!IsCacheable(sceneName))
+		return SharedPtr<File>();
+
+	const String filename = GetCacheFilename(sceneName);
+	FileSystem* fileSystem = GetSubsystem<FileSystem>();
+	if (!fileSystem->FileExists(filename + HEADER_EXTENSION) || !fileSystem->FileExists(filename + SCENE_EXTENSION))
+		return SharedPtr<File>();
+
+	SourceInfo source;
+	if (!GetSourceInfo(sceneName, false, source))
+		return SharedPtr<File>();
+
+	SourceInfo cached{};
+	{
+		File header(context_, filename + HEADER_EXTENSION);
+		if (header.ReadFileID() != CACHE_FILE_ID || header.ReadUShort() != CACHE_VERSION)
+			return SharedPtr<File>();
+		cached.checksum_ = header.ReadUInt();
+		cached.size_ = header.ReadUInt();
+		cached.modified_ = header.ReadUInt();
+	}
+
+	// Unchanged size and time are trusted, otherwise whole source is read for checksum
+	if (!source.modified_ || source.modified_ != cached.modified_ || source.size_ != cached.size_)
+	{
+		if (source.size_ != cached.size_ || !GetSourceInfo(sceneName, true, source) ||
+			source.checksum_ != cached.checksum_)
+		{
+			URHO3D_LOGDEBUGF("Cached scene %s is outdated", sceneName.CString());
+			return SharedPtr<File>();
+		}
+		if (source.modified_)
+			WriteHeader(filename, source); // Touched but same, next check is by time again
+	}
+
+	// Clients are sent resource name and checksum of source, they never see the cached copy
+	SharedPtr<File> file(new SceneFile(context_, filename + SCENE_EXTENSION, sceneName, cached.checksum_));
+	return file->IsOpen() ? file : SharedPtr<File>();
+}
+
+// Header is written last, so interrupted store leaves cache invalid rather than broken
+bool SceneCache::Store(const Urho3D::String& sceneName, const Urho3D::Scene& scene) const
+{
+	SourceInfo source;
+	if (!IsCacheable(sceneName) || !GetSourceInfo(sceneName, true, source))
+		return false;
+
+	const String filename = GetCacheFilename(sceneName);
+	GetSubsystem<FileSystem>()->Delete(filename + HEADER_EXTENSION);
+
+	File file(context_, filename + SCENE_EXTENSION, FILE_WRITE);
+	if (!file.IsOpen() || !scene.Save(file))
+	{
+		URHO3D_LOGWARNINGF("Failed to cache scene %s", sceneName.CString());
+		return false;
+	}
+	file.Close();
+
+	if (!WriteHeader(filename, source))
+		return false;
+	URHO3D_LOGDEBUGF("Cached scene %s", sceneName.CString());
+	return true;
+}
+
+bool SceneCache::IsCacheable(const Urho3D::String& sceneName)
+{
+	return sceneName.EndsWith(".xml", false) || sceneName.EndsWith(".json", false);
+}
+
+bool SceneCache::GetSourceInfo(const Urho3D::String& sceneName, bool checksum, SourceInfo& info) const
+{
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+	SharedPtr<File> source = cache->GetFile(sceneName);
+	if (!source)
+		return false;
+	info.size_ = source->GetSize();
+	info.checksum_ = checksum ? source->GetChecksum() : 0;
+	// Resource file name is empty for packaged ones
+	const String path = source->IsPackaged() ? String::EMPTY : cache->GetResourceFileName(sceneName);
+	info.modified_ = path.Empty() ? 0 : GetSubsystem<FileSystem>()->GetLastModifiedTime(path);
+	return true;
+}
+
+bool SceneCache::WriteHeader(const Urho3D::String& filename, const SourceInfo& info) const
+{
+	File header(context_, filename + HEADER_EXTENSION, FILE_WRITE);
+	if (!header.IsOpen())
+		return false;
+	header.WriteFileID(CACHE_FILE_ID);
+	header.WriteUShort(CACHE_VERSION);
+	header.WriteUInt(info.checksum_);
+	header.WriteUInt(info.size_);
+	header.WriteUInt(info.modified_);
+	return true;
+}
+
+Urho3D::String SceneCache::GetCacheFilename(const Urho3D::String& sceneName) const
+{
+	String name = sceneName;
+	name.Replace('/', '_');
+	name.Replace('\\', '_');
+	return GetSubsystem<ShellConfigurator>()->GetCachePath() + name;
+}
@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef SCENECACHE_H
+#define SCENECACHE_H
+
+#include <Urho3D/Core/Object.h>
+#include "U3SCoreAPI.h"
+
+namespace Urho3D
+{
+class File;
+class Scene;
+} // namespace Urho3D
+
+// Binary copies of XML and JSON scenes in cache path of user profile, validated by source size and modification
+// time. Source checksum is only computed when they differ or are unknown, e.g. for packaged resources.
+class U3SCOREAPI_EXPORT SceneCache : public Urho3D::Object
+{
+	URHO3D_OBJECT(SceneCache, Urho3D::Object)
+
+public:
+	explicit SceneCache(Urho3D::Context* context);
+
+	// Null if scene is binary already or cached copy is missing or outdated
+	Urho3D::SharedPtr<Urho3D::File> GetCachedFile(const Urho3D::String& sceneName) const;
+	bool Store(const Urho3D::String& sceneName, const Urho3D::Scene& scene) const;
+
+	static bool IsCacheable(const Urho3D::String& sceneName);
+
+private:
+	struct SourceInfo
+	{
+		unsigned checksum_;
+		unsigned size_;
+		unsigned modified_; // Zero if source is not a plain file
+	};
+
+	// Checksum is left zero unless requested
+	bool GetSourceInfo(const Urho3D::String& sceneName, bool checksum, SourceInfo& info) const;
+	bool WriteHeader(const Urho3D::String& filename, const SourceInfo& info) const;
+	Urho3D::String GetCacheFilename(const Urho3D::String& sceneName) const;
+};
+
+#endif // SCENECACHE_H
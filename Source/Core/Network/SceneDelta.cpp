@@ -0,0 +1,333 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Math/MathDefs.h>
+#include <Urho3D/Scene/Component.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneEvents.h>
+#include "SceneDelta.h"
+
+using namespace Urho3D;
+
+SceneDelta::SceneDelta(Urho3D::Context* context)
+	: Object(context)
+{
+}
+
+SceneDelta::~SceneDelta() { Stop(); }
+
+void SceneDelta::Start(Urho3D::Scene* scene)
+{
+	Stop();
+	scene_ = scene;
+
+	// Scene state also receives node additions and removals
+	Track(scene);
+	PODVector<Node*> nodes;
+	scene->GetChildren(nodes, true);
+	for (Node* node : nodes)
+		if (node->IsReplicated())
+			Track(node);
+
+	SubscribeToEvent(scene, E_COMPONENTADDED, URHO3D_HANDLER(SceneDelta, OnComponentChanged));
+	SubscribeToEvent(scene, E_COMPONENTREMOVED, URHO3D_HANDLER(SceneDelta, OnComponentChanged));
+	Reset();
+}
+
+void SceneDelta::Stop()
+{
+	if (scene_)
+	{
+		UnsubscribeFromEvent(scene_, E_COMPONENTADDED);
+		UnsubscribeFromEvent(scene_, E_COMPONENTREMOVED);
+	}
+	while (!state_.nodeStates_.Empty())
+		Untrack(state_.nodeStates_.Front().first_);
+	state_.dirtyNodes_.Clear();
+	fileHashes_.Clear();
+	scene_.Reset();
+}
+
+void SceneDelta::Reset()
+{
+	if (!scene_)
+		return;
+	scene_->PrepareNetworkUpdate();
+	CheckFileAttributes();
+	for (unsigned id : state_.dirtyNodes_)
+	{
+		Node* node = scene_->GetNode(id);
+		if (node)
+			Track(node);
+		else
+			Untrack(id);
+	}
+	state_.dirtyNodes_.Clear();
+}
+
+bool SceneDelta::Write(Urho3D::Serializer& dest)
+{
+	if (!scene_)
+		return false;
+
+	// Moves attribute changes made since last network update into replication states
+	scene_->PrepareNetworkUpdate();
+	CheckFileAttributes();
+
+	PODVector<unsigned> removed;
+	Vector<Pair<unsigned, Node*>> changed; // Depth -> Node, so that parents are created before children on load
+	for (unsigned id : state_.dirtyNodes_)
+	{
+		Node* node = scene_->GetNode(id);
+		if (!node)
+		{
+			removed.Push(id);
+			Untrack(id);
+			continue;
+		}
+		Track(node);
+
+		unsigned depth = 0;
+		bool temporary = node->IsTemporary();
+		for (Node* parent = node->GetParent(); parent; parent = parent->GetParent())
+		{
+			++depth;
+			temporary |= parent->IsTemporary();
+		}
+		if (!temporary)
+			changed.Push(MakePair(depth, node));
+	}
+	state_.dirtyNodes_.Clear();
+	Sort(changed.Begin(), changed.End());
+
+	dest.WriteVLE(removed.Size());
+	for (unsigned id : removed)
+		dest.WriteUInt(id);
+
+	// Same layout as Node::Save() without child nodes, every record is sized so that it may be skipped
+	dest.WriteVLE(changed.Size());
+	VectorBuffer record;
+	VectorBuffer componentBuffer;
+	for (const auto& p : changed)
+	{
+		Node* node = p.second_;
+		record.Clear();
+		record.WriteUInt(node->GetID());
+		record.WriteUInt(node->GetParent() ? node->GetParent()->GetID() : 0);
+		if (!node->Animatable::Save(record))
+			return false;
+
+		unsigned components = 0;
+		for (Component* component : node->GetComponents())
+			if (!component->IsTemporary())
+				++components;
+		record.WriteVLE(components);
+		for (Component* component : node->GetComponents())
+		{
+			if (component->IsTemporary())
+				continue;
+			componentBuffer.Clear();
+			if (!component->Save(componentBuffer))
+				return false;
+			record.WriteVLE(componentBuffer.GetSize());
+			record.Write(componentBuffer.GetData(), componentBuffer.GetSize());
+		}
+
+		dest.WriteVLE(record.GetSize());
+		dest.Write(record.GetData(), record.GetSize());
+	}
+	return true;
+}
+
+bool SceneDelta::Apply(Urho3D::Scene& scene, Urho3D::Deserializer& source)
+{
+	const unsigned removed = source.ReadVLE();
+	for (unsigned i = 0; i < removed; ++i)
+	{
+		Node* node = scene.GetNode(source.ReadUInt());
+		if (node && node != &scene)
+			node->Remove();
+	}
+
+	const unsigned changed = source.ReadVLE();
+	PODVector<Component*> loaded;
+	for (unsigned i = 0; i < changed; ++i)
+	{
+		VectorBuffer record(source, source.ReadVLE());
+		const unsigned id = record.ReadUInt();
+		const unsigned parentId = record.ReadUInt();
+		Node* node = scene.GetNode(id);
+		Node* parent = parentId ? scene.GetNode(parentId) : nullptr;
+		if (!node)
+		{
+			if (!parent)
+			{
+				URHO3D_LOGWARNINGF("Saved node %u skipped: parent %u is missing", id, parentId);
+				continue;
+			}
+			node = parent->CreateChild(String::EMPTY, REPLICATED, id);
+		}
+		else if (parent && node->GetParent() != parent)
+			node->SetParent(parent);
+
+		if (!node->Animatable::Load(record))
+			return false;
+
+		loaded.Clear();
+		const unsigned components = record.ReadVLE();
+		for (unsigned j = 0; j < components; ++j)
+		{
+			VectorBuffer componentBuffer(record, record.ReadVLE());
+			const StringHash type = componentBuffer.ReadStringHash();
+			const unsigned componentId = componentBuffer.ReadUInt();
+			Component* component = scene.GetComponent(componentId);
+			if (component && (component->GetNode() != node || component->GetType() != type))
+			{
+				component->Remove();
+				component = nullptr;
+			}
+			if (!component)
+			{
+				const CreateMode mode = Scene::IsReplicatedID(componentId) ? REPLICATED : LOCAL;
+				component = node->CreateComponent(type, mode, componentId);
+			}
+			if (component && component->Load(componentBuffer))
+				loaded.Push(component);
+		}
+
+		// Components which are not in record were removed after previous save
+		const Vector<SharedPtr<Component>> existing = node->GetComponents();
+		for (Component* component : existing)
+			if (!component->IsTemporary() && !loaded.Contains(component))
+				component->Remove();
+
+		node->ApplyAttributes();
+		for (Component* component : loaded)
+			component->ApplyAttributes();
+	}
+	return true;
+}
+
+// Same bookkeeping as network connection does for nodes it replicates
+void SceneDelta::Track(Urho3D::Node* node)
+{
+	NodeReplicationState& nodeState = state_.nodeStates_[node->GetID()];
+	if (nodeState.node_.Get() != node)
+	{
+		nodeState.connection_ = nullptr;
+		nodeState.sceneState_ = &state_;
+		nodeState.node_ = node;
+		nodeState.priorityAcc_ = 0.0f;
+		node->AddReplicationState(&nodeState);
+	}
+	nodeState.markedDirty_ = false;
+	nodeState.dirtyAttributes_.ClearAll();
+	nodeState.dirtyVars_.Clear();
+
+	const unsigned fileHash = HashFileAttributes(node);
+	if (fileAttributes_.GetSize())
+		fileHashes_[node->GetID()] = fileHash;
+	else
+		fileHashes_.Erase(node->GetID());
+
+	auto& componentStates = nodeState.componentStates_;
+	for (auto it = componentStates.Begin(); it != componentStates.End();)
+	{
+		Component* component = it->second_.component_;
+		if (component && component->GetNode() == node)
+		{
+			it->second_.dirtyAttributes_.ClearAll();
+			++it;
+			continue;
+		}
+		if (component)
+			component->CleanupConnection(nullptr);
+		it = componentStates.Erase(it);
+	}
+	for (Component* component : node->GetComponents())
+		if (component->IsReplicated() && !componentStates.Contains(component->GetID()))
+		{
+			ComponentReplicationState& componentState = componentStates[component->GetID()];
+			componentState.connection_ = nullptr;
+			componentState.nodeState_ = &nodeState;
+			componentState.component_ = component;
+			component->AddReplicationState(&componentState);
+		}
+}
+
+// States are found by null connection, which real connections never have
+void SceneDelta::Untrack(unsigned nodeId)
+{
+	const auto it = state_.nodeStates_.Find(nodeId);
+	if (it == state_.nodeStates_.End())
+		return;
+	for (auto& p : it->second_.componentStates_)
+		if (p.second_.component_)
+			p.second_.component_->CleanupConnection(nullptr);
+	if (it->second_.node_)
+		it->second_.node_->CleanupConnection(nullptr);
+	state_.nodeStates_.Erase(it);
+	fileHashes_.Erase(nodeId);
+}
+
+// Tracked nodes are hashed again, so only nodes with such attributes are visited
+void SceneDelta::CheckFileAttributes()
+{
+	for (const auto& p : fileHashes_)
+	{
+		Node* node = scene_->GetNode(p.first_);
+		if (!node || HashFileAttributes(node) != p.second_)
+			state_.dirtyNodes_.Insert(p.first_);
+	}
+}
+
+unsigned SceneDelta::HashFileAttributes(Urho3D::Node* node)
+{
+	fileAttributes_.Clear();
+	for (Component* component : node->GetComponents())
+	{
+		const Vector<AttributeInfo>* attributes = component->GetAttributes();
+		if (component->IsTemporary() || !attributes)
+			continue;
+		for (unsigned i = 0; i < attributes->Size(); ++i)
+		{
+			const AttributeModeFlags mode = attributes->At(i).mode_;
+			if ((mode & AM_FILE) && !(mode & AM_NET))
+				fileAttributes_.WriteVariantData(component->GetAttribute(i));
+		}
+	}
+
+	unsigned hash = 0;
+	const unsigned char* data = fileAttributes_.GetData();
+	for (unsigned i = 0; i < fileAttributes_.GetSize(); ++i)
+		hash = SDBMHash(hash, data[i]);
+	return hash;
+}
+
+void SceneDelta::OnComponentChanged(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace ComponentAdded;
+	const Node* node = static_cast<Node*>(eventData[P_NODE].GetPtr());
+	if (node && node->IsReplicated())
+		state_.dirtyNodes_.Insert(node->GetID());
+}
@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef SCENEDELTA_H
+#define SCENEDELTA_H
+
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Scene/ReplicationState.h>
+#include "U3SCoreAPI.h"
+
+namespace Urho3D
+{
+class Deserializer;
+class Node;
+class Scene;
+class Serializer;
+} // namespace Urho3D
+
+// Changes of replicated nodes since last Reset(). Attribute changes are caught by the same replication states
+// that network connections use, so only changed nodes are visited. Those compare network attributes only, so
+// component attributes saved to file but not sent are compared by hash on nodes that have them.
+class U3SCOREAPI_EXPORT SceneDelta : public Urho3D::Object
+{
+	URHO3D_OBJECT(SceneDelta, Urho3D::Object)
+
+public:
+	explicit SceneDelta(Urho3D::Context* context);
+	~SceneDelta();
+
+	void Start(Urho3D::Scene* scene);
+	void Stop();
+	void Reset();
+
+	// Temporary nodes and their children are skipped
+	bool Write(Urho3D::Serializer& dest);
+
+	bool IsStarted() const { return scene_.NotNull(); }
+
+	static bool Apply(Urho3D::Scene& scene, Urho3D::Deserializer& source);
+
+private:
+	void Track(Urho3D::Node* node);
+	void Untrack(unsigned nodeId);
+	void CheckFileAttributes();
+	unsigned HashFileAttributes(Urho3D::Node* node);
+
+	void OnComponentChanged(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+
+	Urho3D::WeakPtr<Urho3D::Scene> scene_;
+	Urho3D::SceneReplicationState state_; // Node states are referenced by tracked nodes, so addresses must be stable
+	Urho3D::HashMap<unsigned, unsigned> fileHashes_; // Node ID -> Hash of file only attributes, if node has any
+	Urho3D::VectorBuffer fileAttributes_;			  // Reused for hashing
+};
+
+#endif // SCENEDELTA_H
@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef SCENESOURCE_H
+#define SCENESOURCE_H
+
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include "U3SCoreAPI.h"
+
+// Scene takes file name and checksum it sends to joining clients from the source it was loaded from.
+// Binary copies (cache, saved game, snapshot) report those of original scene resource instead of own ones.
+class U3SCOREAPI_EXPORT SceneFile : public Urho3D::File
+{
+public:
+	SceneFile(Urho3D::Context* context,
+			  const Urho3D::String& fileName,
+			  const Urho3D::String& sceneName,
+			  unsigned checksum)
+		: File(context, fileName)
+		, sceneName_(sceneName)
+		, checksum_(checksum)
+	{
+	}
+
+	const Urho3D::String& GetName() const override { return sceneName_; }
+	unsigned GetChecksum() override { return checksum_; }
+
+private:
+	Urho3D::String sceneName_;
+	unsigned checksum_;
+};
+
+class U3SCOREAPI_EXPORT SceneBuffer : public Urho3D::MemoryBuffer
+{
+public:
+	SceneBuffer(const void* data, unsigned size, const Urho3D::String& sceneName, unsigned checksum)
+		: MemoryBuffer(data, size)
+		, sceneName_(sceneName)
+		, checksum_(checksum)
+	{
+	}
+
+	const Urho3D::String& GetName() const override { return sceneName_; }
+	unsigned GetChecksum() override { return checksum_; }
+
+private:
+	Urho3D::String sceneName_;
+	unsigned checksum_;
+};
+
+#endif // SCENESOURCE_H
@@ -20,23 +20,71 @@
 // THE SOFTWARE.
 //
 
+#include <Urho3D/Core/CoreEvents.h>
 #include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
 #include <Urho3D/Network/Network.h>
 #include <Urho3D/Network/NetworkEvents.h>
+#include <Urho3D/Network/NetworkPriority.h>
+#include <Urho3D/Physics/PhysicsEvents.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
 #include <Urho3D/Resource/ResourceCache.h>
 #include <Urho3D/Resource/XMLFile.h>
+#include <Urho3D/Scene/ReplicationState.h>
 #include <Urho3D/Scene/SceneEvents.h>
+#include <thread>
+#include "Config/ConfigDefs.h"
+#include "Config/ConfigEvents.h"
+#include "Core/ShellConfigurator.h"
+#include "Input/InputReceiver.h"
 #include "NetworkEvents.h"
+#include "SaveGame.h"
+#include "SceneCache.h"
+#include "SceneSource.h"
 #include "Server.h"
 #include "ServerDefs.h"
 
+#define AUTOSAVE_NAME "Autosave"
+#define BASE_PRIORITY 100.0f		  // Urho default: every update is sent
+#define INTEREST_BASE_PRIORITY 200.0f // Full rate within half of interest radius
+#define MAX_DELTA_SEGMENTS 16
+
 using namespace Urho3D;
 
+static std::chrono::steady_clock::duration ToDuration(float seconds)
+{
+	return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(seconds));
+}
+
+template <typename Duration> static float ToMilliseconds(Duration duration)
+{
+	return std::chrono::duration<float, std::milli>(duration).count();
+}
+
 Server::Server(Urho3D::Context* context)
 	: Object(context)
 	, scene_(context)
+	, sceneCache_(context)
+	, snapshotChecksum_(0)
+	, delta_(context)
+	, ticks_{}
+	, current_{}
+	, loadMemory_(0)
+	, finishResourcesMs_(-1)
+	, tickCount_(0)
+	, playersCount_(0)
+	, maxPlayers_(context->GetSubsystem<ShellConfigurator>()->GetMaxPlayers())
+	, tickRate_(0)
+	, overruns_(0)
+	, statsOverruns_(0)
+	, autosaveSegments_(0)
+	, statsInterval_(0.0f)
+	, interestRadius_(context->GetSubsystem<ShellConfigurator>()->GetInterestRadius())
+	, autosaveInterval_(0.0f)
 	, pausable_(false)
 	, remote_(false)
+	, storeCache_(false)
+	, resyncNodes_(false)
 {
 	URHO3D_LOGTRACE("Server::Server");
 	SubscribeToEvent(E_CLIENTCONNECTED, URHO3D_HANDLER(Server, OnClientConnected));
@@ -45,6 +93,22 @@ Server::Server(Urho3D::Context* context)
 	SubscribeToEvent(E_CLIENTSCENELOADED, URHO3D_HANDLER(Server, OnClientSceneLoaded));
 	SubscribeToEvent(E_SERVERSIDERESPAWNED, URHO3D_HANDLER(Server, OnServerSideRespawned));
 	SubscribeToEvent(E_SERVERSIDESPAWNED, URHO3D_HANDLER(Server, OnServerSideSpawned));
+
+	SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(Server, OnBeginFrame));
+	SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(Server, OnEndFrame));
+	SubscribeToEvent(&scene_, E_SCENEUPDATE, URHO3D_HANDLER(Server, OnSceneUpdate));
+	SubscribeToEvent(&scene_, E_SCENEPOSTUPDATE, URHO3D_HANDLER(Server, OnScenePostUpdate));
+	SubscribeToEvent(E_PHYSICSPRESTEP, URHO3D_HANDLER(Server, OnPhysicsPreStep));
+	SubscribeToEvent(E_PHYSICSPOSTSTEP, URHO3D_HANDLER(Server, OnPhysicsPostStep));
+	// Load test bots run own network instances in the same process
+	Network* network = GetSubsystem<Network>();
+	SubscribeToEvent(network, E_NETWORKUPDATE, URHO3D_HANDLER(Server, OnNetworkUpdate));
+	SubscribeToEvent(network, E_NETWORKUPDATESENT, URHO3D_HANDLER(Server, OnNetworkUpdateSent));
+	SubscribeToEvent(&scene_, E_NODEADDED, URHO3D_HANDLER(Server, OnNodeAdded));
+	SubscribeToEvent(&scene_, E_ASYNCLOADPROGRESS, URHO3D_HANDLER(Server, OnAsyncLoadProgress));
+	SubscribeToEvent(&scene_, E_ASYNCLOADFINISHED, URHO3D_HANDLER(Server, OnAsyncLoadFinished));
+	SubscribeToEvent(E_GAMESAVED, URHO3D_HANDLER(Server, OnGameSaved));
+	SubscribeToEvent(E_CONFIGCHANGED, URHO3D_HANDLER(Server, OnConfigChanged));
 }
 
 Server::~Server()
@@ -56,13 +120,65 @@ Server::~Server()
 bool Server::LoadScene(const Urho3D::String& sceneName)
 {
 	URHO3D_LOGTRACEF("Server::LoadScene(%s)", sceneName.CString());
-	SharedPtr<File> file = GetSubsystem<ResourceCache>()->GetFile(sceneName);
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+
+	// Same budget for node instantiation and for finishing background loaded resources on main thread. Resource
+	// cache is shared with the rest of application, so its own budget is restored once loading is over.
+	const int budget = static_cast<int>(GetSubsystem<ShellConfigurator>()->GetAsyncLoadingMs());
+	scene_.SetAsyncLoadingMs(budget);
+	loadMemory_ = cache->GetTotalMemoryUse();
+	sceneName_ = sceneName;
+	storeCache_ = false;
+	loadingSave_.Clear();
+	savedState_.Clear();
+	if (!BeginLoading(sceneName))
+		return false;
+	if (finishResourcesMs_ < 0)
+		finishResourcesMs_ = cache->GetFinishBackgroundResourcesMs();
+	cache->SetFinishBackgroundResourcesMs(budget);
+	return true;
+}
+
+bool Server::BeginLoading(const Urho3D::String& sceneName)
+{
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+
+	// Saved game is unpacked into cache path and then loaded as usual binary scene. Clients are sent its original
+	// scene resource and load the saved state through replication.
+	if (::SaveGame::IsSaveFile(sceneName))
+	{
+		const String sceneFilename = GetSubsystem<ShellConfigurator>()->GetCachePath() + "SaveGame.bin";
+		if (!GetSubsystem<::SaveGame>()->Extract(sceneName, sceneFilename, sceneName_, savedState_))
+			return false;
+		const SharedPtr<File> source = cache->GetFile(sceneName_);
+		if (!source)
+		{
+			URHO3D_LOGERRORF(
+				"Failed to load saved game %s: scene %s is missing.", sceneName.CString(), sceneName_.CString());
+			return false;
+		}
+		loadingSave_ = sceneName;
+		SharedPtr<File> file(new SceneFile(context_, sceneFilename, sceneName_, source->GetChecksum()));
+		return scene_.LoadAsync(file, LOAD_SCENE_AND_RESOURCES);
+	}
+
+	// Text scenes are parsed only once, later loads use binary copy from user profile
+	SharedPtr<File> cached = sceneCache_.GetCachedFile(sceneName);
+	if (cached)
+	{
+		URHO3D_LOGINFOF("Loading scene %s from cache", sceneName.CString());
+		return scene_.LoadAsync(cached, LOAD_SCENE_AND_RESOURCES);
+	}
+	storeCache_ = SceneCache::IsCacheable(sceneName);
+
+	SharedPtr<File> file = cache->GetFile(sceneName);
+	// Resources referenced by scene file are preloaded in background before nodes are created
 	if (sceneName.EndsWith(".xml", false))
-		return scene_.LoadAsyncXML(file);
+		return scene_.LoadAsyncXML(file, LOAD_SCENE_AND_RESOURCES);
 	else if (sceneName.EndsWith(".bin", false))
-		return scene_.LoadAsync(file);
+		return scene_.LoadAsync(file, LOAD_SCENE_AND_RESOURCES);
 	else if (sceneName.EndsWith(".json", false))
-		return scene_.LoadAsyncJSON(file);
+		return scene_.LoadAsyncJSON(file, LOAD_SCENE_AND_RESOURCES);
 	else
 	{
 		URHO3D_LOGERRORF("Failed to load scene %s: unsupported file format.", sceneName.CString());
@@ -80,6 +196,11 @@ void Server::ClearScene()
 bool Server::Start(unsigned short port)
 {
 	URHO3D_LOGTRACEF("Server::Start(%u)", port);
+	TakeSnapshot();
+	autosaveInterval_ = GetSubsystem<ShellConfigurator>()->GetAutosaveInterval();
+	nextAutosave_ = Clock::now() + ToDuration(autosaveInterval_);
+	ApplyTickRate();
+	ApplyInterestAll();
 	return GetSubsystem<Network>()->StartServer(port);
 }
 
@@ -94,57 +215,427 @@ void Server::Stop()
 	}
 	if (remote_)
 		network->SetDiscoveryBeacon(Variant::emptyVariantMap);
-	nodes_.Clear();
+	beacon_.Clear();
+	players_.Clear();
+	freeSlots_.Clear();
+	connections_.Clear();
+	playerNodes_.Clear();
+	pendingNodes_.Clear();
+	playersCount_ = 0;
+	delta_.Stop();
 	scene_.Clear();
+	RestoreResourcesBudget();
+	snapshot_.Clear();
+	autosaveInterval_ = 0.0f;
 	remote_ = false;
 }
 
+// Scene is restored from memory: resources are still in cache, so nothing is read from disk
+bool Server::RestartScene()
+{
+	URHO3D_LOGTRACE("Server::RestartScene");
+	if (!snapshot_.GetSize())
+	{
+		URHO3D_LOGERROR("Failed to restart scene: no snapshot taken");
+		return false;
+	}
+
+	// Player nodes are not part of snapshot and are removed with the rest of scene
+	for (PlayerSlot& player : players_)
+		player.nodeId_ = 0;
+	playerNodes_.Clear();
+	delta_.Stop(); // Next autosave is full one
+
+	// Keep file name and checksum, otherwise clients joining after restart would not load scene resource
+	SceneBuffer source(snapshot_.GetData(), snapshot_.GetSize(), snapshotName_, snapshotChecksum_);
+	if (!scene_.Load(source))
+	{
+		URHO3D_LOGERROR("Failed to restart scene: snapshot is broken");
+		return false;
+	}
+	resyncNodes_ = true;
+	ApplyTickRate(); // Snapshot holds physics rate as authored
+	ApplyInterestAll();
+	SendEvent(E_SCENERESTARTED);
+	return true;
+}
+
 void Server::MakeVisible(const Urho3D::String& serverName)
 {
 	URHO3D_LOGTRACEF("Server::MakeVisible(%s)", serverName.CString());
-	VariantMap hostBeacon;
-	hostBeacon[SV_NAME] = serverName;
-	hostBeacon[SV_SCENE] = scene_.GetFileName();
-	hostBeacon[SV_PLAYERS] = 0;
-	hostBeacon[SV_PLAYERS_MAX] = 128;
-	GetSubsystem<Network>()->SetDiscoveryBeacon(hostBeacon);
+	beacon_[SV_NAME] = serverName;
+	beacon_[SV_SCENE] = sceneName_;
+	beacon_[SV_PLAYERS] = playersCount_;
+	beacon_[SV_PLAYERS_MAX] = maxPlayers_;
+	GetSubsystem<Network>()->SetDiscoveryBeacon(beacon_);
 	remote_ = true;
 	SendEvent(E_REMOTESERVERSTARTED);
 }
 
+void Server::SetMaxPlayers(unsigned maxPlayers)
+{
+	maxPlayers_ = maxPlayers;
+	UpdateBeacon();
+}
+
+void Server::SetInterestRadius(float radius)
+{
+	URHO3D_LOGTRACEF("Server::SetInterestRadius(%f)", radius);
+	interestRadius_ = Max(radius, 0.0f);
+	ApplyInterestAll();
+}
+
 void Server::SetUpdate(bool update)
 {
 	if (pausable_)
 		scene_.SetUpdateEnabled(update);
 }
 
-void Server::OnClientConnected(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+void Server::SetTickRate(unsigned tickRate)
 {
-	using namespace ClientConnected;
-	const Connection* connection = static_cast<Connection*>(eventData[P_CONNECTION].GetPtr());
-	URHO3D_LOGTRACEF("Server::OnClientConnected %s", connection->ToString().CString());
+	URHO3D_LOGTRACEF("Server::SetTickRate(%u)", tickRate);
+	tickRate_ = tickRate;
+	nextTick_ = Clock::now();
+	ApplyTickRate();
 }
 
-void Server::OnClientDisconnected(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+void Server::SetNetworkRate(unsigned networkRate) { GetSubsystem<Network>()->SetUpdateFps(networkRate); }
+
+unsigned Server::GetNetworkRate() const { return GetSubsystem<Network>()->GetUpdateFps(); }
+
+const Server::TickStats& Server::GetTickStats(unsigned age) const
 {
-	using namespace ClientConnected;
-	const Connection* connection = static_cast<Connection*>(eventData[P_CONNECTION].GetPtr());
-	const String address = connection->ToString();
-	auto it = nodes_.Find(address);
-	if (it != nodes_.End())
+	return ticks_[(tickCount_ + TICK_HISTORY - 1 - age % TICK_HISTORY) % TICK_HISTORY];
+}
+
+void Server::ApplyTickRate()
+{
+	// Run exactly one physics step per server tick
+	PhysicsWorld* physics = scene_.GetComponent<PhysicsWorld>();
+	if (physics && tickRate_)
+		physics->SetFps(static_cast<int>(tickRate_));
+}
+
+bool Server::SaveGame(const Urho3D::String& name)
+{
+	URHO3D_LOGTRACEF("Server::SaveGame(%s)", name.CString());
+	PODVector<Node*> players;
+	ExcludePlayers(players);
+	const bool result = GetSubsystem<::SaveGame>()->Save(name, scene_, sceneName_);
+	RestorePlayers(players);
+	return result;
+}
+
+bool Server::StartReplay(unsigned playerId, const Urho3D::String& name)
+{
+	URHO3D_LOGTRACEF("Server::StartReplay(%u, %s)", playerId, name.CString());
+	const unsigned nodeId = GetPlayerNode(playerId);
+	Node* node = nodeId ? scene_.GetNode(nodeId) : nullptr;
+	InputReceiver* receiver = node ? node->GetComponent<InputReceiver>() : nullptr;
+	if (!receiver)
+	{
+		URHO3D_LOGERRORF("Failed to replay input %s: player %u is not spawned", name.CString(), playerId);
+		return false;
+	}
+	return receiver->StartReplay(name);
+}
+
+void Server::StopReplay(unsigned playerId)
+{
+	const unsigned nodeId = GetPlayerNode(playerId);
+	Node* node = nodeId ? scene_.GetNode(nodeId) : nullptr;
+	InputReceiver* receiver = node ? node->GetComponent<InputReceiver>() : nullptr;
+	if (receiver)
+		receiver->StopReplay();
+}
+
+// Base save is compacted with full save every few segments, so that loading does not replay long history
+void Server::Autosave()
+{
+	::SaveGame* saveGame = GetSubsystem<::SaveGame>();
+	if (saveGame->IsSaving())
+		return; // Changes keep accumulating until next interval
+
+	PODVector<Node*> players;
+	ExcludePlayers(players);
+	if (!delta_.IsStarted() || autosaveSegments_ >= MAX_DELTA_SEGMENTS)
+	{
+		if (saveGame->Save(AUTOSAVE_NAME, scene_, sceneName_, false))
+		{
+			if (delta_.IsStarted())
+				delta_.Reset();
+			else
+				delta_.Start(&scene_);
+			autosaveSegments_ = 0;
+		}
+	}
+	else if (saveGame->SaveDelta(AUTOSAVE_NAME, delta_))
+		++autosaveSegments_;
+	RestorePlayers(players);
+}
+
+// Player nodes are left out of saves: on load players are spawned again when they join
+void Server::ExcludePlayers(Urho3D::PODVector<Urho3D::Node*>& players)
+{
+	for (const auto& p : playerNodes_)
+	{
+		Node* node = scene_.GetNode(p.first_);
+		if (node && !node->IsTemporary())
+		{
+			node->SetTemporary(true);
+			players.Push(node);
+		}
+	}
+}
+
+void Server::RestorePlayers(const Urho3D::PODVector<Urho3D::Node*>& players)
+{
+	for (Node* node : players)
+		node->SetTemporary(false);
+}
+
+void Server::RestoreResourcesBudget()
+{
+	if (finishResourcesMs_ < 0)
+		return;
+	GetSubsystem<ResourceCache>()->SetFinishBackgroundResourcesMs(finishResourcesMs_);
+	finishResourcesMs_ = -1;
+}
+
+void Server::TakeSnapshot()
+{
+	snapshot_.Clear();
+	snapshotName_ = scene_.GetFileName();
+	snapshotChecksum_ = scene_.GetChecksum();
+	if (!scene_.Save(snapshot_))
+	{
+		URHO3D_LOGWARNING("Failed to take scene snapshot, restart will not be possible");
+		snapshot_.Clear();
+	}
+}
+
+void Server::LogTickStats()
+{
+	const unsigned count = GetTickStatsCount();
+	if (!count)
+		return;
+	TickStats average{};
+	float peak = 0.0f;
+	for (unsigned i = 0; i < count; ++i)
+	{
+		const TickStats& tick = ticks_[i];
+		average.total_ += tick.total_;
+		average.scene_ += tick.scene_;
+		average.physics_ += tick.physics_;
+		average.network_ += tick.network_;
+		peak = Max(peak, tick.total_);
+	}
+	const float scale = 1.0f / static_cast<float>(count);
+	URHO3D_LOGINFOF("Server last %u ticks: avg %.2f ms (scene %.2f, physics %.2f, network %.2f), max %.2f ms, "
+					"overruns %u",
+					count,
+					average.total_ * scale,
+					average.scene_ * scale,
+					average.physics_ * scale,
+					average.network_ * scale,
+					peak,
+					statsOverruns_);
+	statsOverruns_ = 0;
+}
+
+unsigned Server::GetPlayerId(const Urho3D::Connection* connection) const
+{
+	const auto it = connections_.Find(connection);
+	return it != connections_.End() ? it->second_ : M_MAX_UNSIGNED;
+}
+
+unsigned Server::GetPlayerIdByNode(unsigned nodeId) const
+{
+	const auto it = playerNodes_.Find(nodeId);
+	return it != playerNodes_.End() ? it->second_ : M_MAX_UNSIGNED;
+}
+
+Urho3D::Connection* Server::GetPlayerConnection(unsigned playerId) const
+{
+	return playerId < players_.Size() ? players_[playerId].connection_ : nullptr;
+}
+
+unsigned Server::GetPlayerNode(unsigned playerId) const
+{
+	return playerId < players_.Size() ? players_[playerId].nodeId_ : 0;
+}
+
+unsigned Server::AddPlayer(Urho3D::Connection* connection)
+{
+	unsigned playerId;
+	if (freeSlots_.Empty())
+	{
+		playerId = players_.Size();
+		players_.Push({connection, 0});
+	}
+	else
+	{
+		playerId = freeSlots_.Back();
+		freeSlots_.Pop();
+		players_[playerId] = {connection, 0};
+	}
+	connections_[connection] = playerId;
+	++playersCount_;
+	UpdateBeacon();
+	return playerId;
+}
+
+void Server::RemovePlayer(unsigned playerId)
+{
+	PlayerSlot& player = players_[playerId];
+	if (player.nodeId_)
 	{
-		Node* node = scene_.GetNode(it->second_);
+		Node* node = scene_.GetNode(player.nodeId_);
 		if (node)
 			node->Remove();
-		nodes_.Erase(it);
+		playerNodes_.Erase(player.nodeId_);
+	}
+	connections_.Erase(player.connection_);
+	player = {nullptr, 0};
+	freeSlots_.Push(playerId);
+	--playersCount_;
+	UpdateBeacon();
+}
+
+void Server::SpawnPlayer(unsigned playerId, unsigned nodeId)
+{
+	PlayerSlot& player = players_[playerId];
+	player.nodeId_ = nodeId;
+	playerNodes_[nodeId] = playerId;
+	Node* node = scene_.GetNode(nodeId);
+	// Owner always receives own node updates regardless of its interest area
+	if (node)
+		node->SetOwner(player.connection_);
+}
+
+void Server::ApplyInterest(Urho3D::Node* node)
+{
+	NetworkPriority* priority = node->GetComponent<NetworkPriority>();
+	if (!priority)
+	{
+		if (interestRadius_ <= 0.0f)
+			return;
+		priority = node->CreateComponent<NetworkPriority>(LOCAL);
+		priority->SetTemporary(true); // Server setting, kept out of scene cache, snapshot and saves
+	}
+	else if (priority->IsReplicated())
+		return; // Scene author's own settings win
+
+	if (interestRadius_ > 0.0f)
+	{
+		// Full rate within half radius, fading to no updates at radius
+		priority->SetBasePriority(INTEREST_BASE_PRIORITY);
+		priority->SetDistanceFactor(INTEREST_BASE_PRIORITY / interestRadius_);
+		priority->SetMinPriority(0.0f);
+	}
+	else
+	{
+		priority->SetBasePriority(BASE_PRIORITY);
+		priority->SetDistanceFactor(0.0f);
+	}
+}
+
+void Server::ApplyInterestAll()
+{
+	pendingNodes_.Clear();
+	PODVector<Node*> nodes;
+	scene_.GetChildren(nodes, true);
+	for (Node* node : nodes)
+		if (node->IsReplicated())
+			ApplyInterest(node);
+}
+
+void Server::UpdateInterest()
+{
+	for (unsigned nodeId : pendingNodes_)
+	{
+		Node* node = scene_.GetNode(nodeId);
+		if (node)
+			ApplyInterest(node);
+	}
+	pendingNodes_.Clear();
+
+	// Connection position is what NetworkPriority measures distance of nodes from
+	for (const PlayerSlot& player : players_)
+	{
+		if (!player.nodeId_)
+			continue;
+		const Node* node = scene_.GetNode(player.nodeId_);
+		if (node)
+			player.connection_->SetPosition(node->GetWorldPosition());
 	}
-	URHO3D_LOGTRACEF("Server::OnClientDisconnected %s", address.CString());
+}
+
+// Restored nodes reuse IDs of removed ones. First update after restart only removes them from clients, because
+// replication state of connections still refers to old nodes, so they are marked dirty again to be sent as new.
+void Server::ResyncNodes()
+{
+	resyncNodes_ = false;
+	const NetworkState* state = scene_.GetNetworkState();
+	if (!state)
+		return;
+
+	PODVector<Node*> nodes;
+	scene_.GetChildren(nodes, true);
+	for (ReplicationState* replication : state->replicationStates_)
+	{
+		SceneReplicationState* sceneState = static_cast<NodeReplicationState*>(replication)->sceneState_;
+		for (const Node* node : nodes)
+			if (node->IsReplicated())
+				sceneState->dirtyNodes_.Insert(node->GetID());
+	}
+}
+
+void Server::UpdateBeacon()
+{
+	if (remote_)
+	{
+		beacon_[SV_PLAYERS] = playersCount_;
+		beacon_[SV_PLAYERS_MAX] = maxPlayers_;
+		GetSubsystem<Network>()->SetDiscoveryBeacon(beacon_);
+	}
+}
+
+void Server::OnClientConnected(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace ClientConnected;
+	Connection* connection = static_cast<Connection*>(eventData[P_CONNECTION].GetPtr());
+	if (playersCount_ >= maxPlayers_)
+	{
+		URHO3D_LOGINFOF("Rejected client %s: server is full (%u players).",
+						connection->ToString().CString(),
+						maxPlayers_);
+		connection->Disconnect();
+		return;
+	}
+	const unsigned playerId = AddPlayer(connection);
+	URHO3D_LOGTRACEF("Server::OnClientConnected %s player %u", connection->ToString().CString(), playerId);
+}
+
+void Server::OnClientDisconnected(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace ClientDisconnected;
+	const Connection* connection = static_cast<Connection*>(eventData[P_CONNECTION].GetPtr());
+	const unsigned playerId = GetPlayerId(connection);
+	if (playerId != M_MAX_UNSIGNED)
+		RemovePlayer(playerId);
+	URHO3D_LOGTRACEF("Server::OnClientDisconnected player %u", playerId);
 }
 
 void Server::OnClientIdentity(Urho3D::StringHash, Urho3D::VariantMap& eventData)
 {
 	using namespace ClientIdentity;
 	Connection* connection = static_cast<Connection*>(eventData[P_CONNECTION].GetPtr());
+	if (GetPlayerId(connection) == M_MAX_UNSIGNED)
+	{
+		eventData[P_ALLOW] = false; // Rejected on connect
+		return;
+	}
 	connection->SetScene(&scene_);
 	const String& clientName = eventData[CL_NAME].GetString();
 	URHO3D_LOGTRACEF("Server::OnServerIdentity %s name %s", connection->ToString().CString(), clientName.CString());
@@ -161,25 +652,186 @@ void Server::OnServerSideRespawned(Urho3D::StringHash, Urho3D::VariantMap& event
 {
 	using namespace ServerSideRespawned;
 	const Connection* connection = static_cast<Connection*>(eventData[P_CONNECTION].GetPtr());
-	const String address = connection->ToString();
-	const unsigned nodeId = eventData[P_NODE].GetInt();
-	auto it = nodes_.Find(address);
-	if (it != nodes_.End())
+	if (!connection->IsClient())
+		return;
+	const unsigned playerId = GetPlayerId(connection);
+	if (playerId != M_MAX_UNSIGNED)
 	{
-		Node* node = scene_.GetNode(it->second_);
-		if (node)
-			node->Remove();
-		it->second_ = nodeId;
+		PlayerSlot& player = players_[playerId];
+		if (player.nodeId_)
+		{
+			Node* node = scene_.GetNode(player.nodeId_);
+			if (node)
+				node->Remove();
+			playerNodes_.Erase(player.nodeId_);
+		}
+		SpawnPlayer(playerId, eventData[P_NODE].GetUInt());
 	}
-	URHO3D_LOGTRACEF("Server::OnServerSideDespawned %s", address.CString());
+	URHO3D_LOGTRACEF("Server::OnServerSideRespawned player %u", playerId);
 }
 
 void Server::OnServerSideSpawned(Urho3D::StringHash, Urho3D::VariantMap& eventData)
 {
 	using namespace ServerSideSpawned;
 	const Connection* connection = static_cast<Connection*>(eventData[P_CONNECTION].GetPtr());
-	const String address = connection->ToString();
-	const unsigned nodeId = eventData[P_NODE].GetInt();
-	nodes_[address] = nodeId;
-	URHO3D_LOGTRACEF("Server::OnClientSceneLoaded %s node %u", address.CString(), nodeId);
+	if (!connection->IsClient())
+		return;
+	const unsigned playerId = GetPlayerId(connection);
+	const unsigned nodeId = eventData[P_NODE].GetUInt();
+	if (playerId != M_MAX_UNSIGNED)
+		SpawnPlayer(playerId, nodeId);
+	URHO3D_LOGTRACEF("Server::OnServerSideSpawned player %u node %u", playerId, nodeId);
+}
+
+void Server::OnBeginFrame(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	tickStart_ = Clock::now();
+	current_ = {};
+}
+
+void Server::OnEndFrame(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	const Clock::time_point now = Clock::now();
+	current_.total_ = ToMilliseconds(now - tickStart_);
+	current_.scene_ -= current_.physics_;
+	ticks_[tickCount_ % TICK_HISTORY] = current_;
+	++tickCount_;
+
+	if (statsInterval_ > 0.0f && now >= nextStats_)
+	{
+		if (nextStats_ != Clock::time_point{})
+			LogTickStats();
+		nextStats_ = now + ToDuration(statsInterval_);
+	}
+
+	if (autosaveInterval_ > 0.0f && now >= nextAutosave_)
+	{
+		Autosave();
+		nextAutosave_ = now + ToDuration(autosaveInterval_);
+	}
+
+	if (!tickRate_)
+		return;
+
+	// Sleep until next tick deadline instead of spinning in engine frame limiter
+	const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / tickRate_;
+	nextTick_ += period;
+	if (nextTick_ > now)
+		std::this_thread::sleep_until(nextTick_);
+	else
+	{
+		++overruns_;
+		++statsOverruns_;
+		URHO3D_LOGDEBUGF("Server tick overrun: %.2f ms of %.2f ms budget.", current_.total_, ToMilliseconds(period));
+		nextTick_ = now; // Do not try to catch up lost ticks
+	}
+}
+
+void Server::OnSceneUpdate(Urho3D::StringHash, Urho3D::VariantMap&) { stageStart_ = Clock::now(); }
+
+void Server::OnScenePostUpdate(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	current_.scene_ += ToMilliseconds(Clock::now() - stageStart_);
+}
+
+void Server::OnPhysicsPreStep(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace PhysicsPreStep;
+	const PhysicsWorld* world = static_cast<PhysicsWorld*>(eventData[P_WORLD].GetPtr());
+	if (world && world->GetScene() == &scene_)
+		physicsStart_ = Clock::now();
+}
+
+void Server::OnPhysicsPostStep(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace PhysicsPostStep;
+	const PhysicsWorld* world = static_cast<PhysicsWorld*>(eventData[P_WORLD].GetPtr());
+	if (world && world->GetScene() == &scene_)
+		current_.physics_ += ToMilliseconds(Clock::now() - physicsStart_);
+}
+
+void Server::OnNetworkUpdate(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	networkStart_ = Clock::now();
+	UpdateInterest();
+}
+
+void Server::OnNetworkUpdateSent(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	if (resyncNodes_)
+		ResyncNodes();
+	current_.network_ += ToMilliseconds(Clock::now() - networkStart_);
+}
+
+void Server::OnNodeAdded(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace NodeAdded;
+	// Components are not created yet, so defer to next network update. Loaded scene is handled in Start.
+	const Node* node = static_cast<Node*>(eventData[P_NODE].GetPtr());
+	if (interestRadius_ > 0.0f && node->IsReplicated() && !scene_.IsAsyncLoading())
+		pendingNodes_.Push(node->GetID());
+}
+
+// Stored before Start() adds interest priorities, so cache holds scene as authored
+void Server::OnAsyncLoadFinished(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	RestoreResourcesBudget();
+	if (storeCache_)
+		sceneCache_.Store(sceneName_, scene_);
+	storeCache_ = false;
+
+	if (!loadingSave_.Empty())
+	{
+		GetSubsystem<::SaveGame>()->ApplyDeltas(loadingSave_, scene_, savedState_);
+
+		using namespace GameLoaded;
+		VariantMap& eventData = GetEventDataMap();
+		eventData[P_STATE] = savedState_;
+		SendEvent(E_GAMELOADED, eventData);
+		loadingSave_.Clear();
+		savedState_.Clear();
+	}
+}
+
+void Server::OnGameSaved(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace GameSaved;
+	// Changes already written to delta are lost with failed segment, so only full save is consistent again
+	if (!eventData[P_SUCCESS].GetBool() && eventData[P_NAME].GetString() == AUTOSAVE_NAME)
+		autosaveSegments_ = MAX_DELTA_SEGMENTS;
+}
+
+// Network rate parameter sets Network update FPS directly, the rest are kept by ShellConfigurator
+void Server::OnConfigChanged(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	using namespace ConfigChanged;
+	const StringVector& parameters = eventData[P_PARAMETERS].GetStringVector();
+	const ShellConfigurator* configurator = GetSubsystem<ShellConfigurator>();
+	// Listen servers keep tick rate 0, so that client render loop is never throttled
+	if (tickRate_ && parameters.Contains(CP_TICK_RATE))
+		SetTickRate(configurator->GetTickRate());
+	if (parameters.Contains(CP_MAX_PLAYERS))
+		SetMaxPlayers(configurator->GetMaxPlayers());
+	if (parameters.Contains(CP_INTEREST_RADIUS))
+		SetInterestRadius(configurator->GetInterestRadius());
+}
+
+void Server::OnAsyncLoadProgress(Urho3D::StringHash, Urho3D::VariantMap& eventData)
+{
+	const unsigned long long memory = GetSubsystem<ResourceCache>()->GetTotalMemoryUse();
+	const float progress = eventData[AsyncLoadProgress::P_PROGRESS].GetFloat();
+	const int loadedNodes = eventData[AsyncLoadProgress::P_LOADEDNODES].GetInt();
+	const int totalNodes = eventData[AsyncLoadProgress::P_TOTALNODES].GetInt();
+	const int loadedResources = eventData[AsyncLoadProgress::P_LOADEDRESOURCES].GetInt();
+	const int totalResources = eventData[AsyncLoadProgress::P_TOTALRESOURCES].GetInt();
+
+	using namespace SceneLoadProgress;
+	VariantMap& progressData = GetEventDataMap();
+	progressData[P_PROGRESS] = progress;
+	progressData[P_LOADEDNODES] = loadedNodes;
+	progressData[P_TOTALNODES] = totalNodes;
+	progressData[P_LOADEDRESOURCES] = loadedResources;
+	progressData[P_TOTALRESOURCES] = totalResources;
+	progressData[P_LOADEDBYTES] = memory > loadMemory_ ? memory - loadMemory_ : 0ull;
+	SendEvent(E_SCENELOADPROGRESS, progressData);
 }
@@ -24,14 +24,34 @@
 #define SERVER_H
 
 #include <Urho3D/Core/Object.h>
+#include <Urho3D/IO/VectorBuffer.h>
 #include <Urho3D/Scene/Scene.h>
+#include <chrono>
+#include "SceneCache.h"
+#include "SceneDelta.h"
 #include "U3SCoreAPI.h"
 
+namespace Urho3D
+{
+class Connection;
+class Node;
+}
+
 class U3SCOREAPI_EXPORT Server : public Urho3D::Object
 {
 	URHO3D_OBJECT(Server, Urho3D::Object)
 
 public:
+	struct TickStats
+	{
+		float total_;	// Whole tick, ms
+		float scene_;	// Scene update except physics, ms
+		float physics_; // Physics steps, ms
+		float network_; // Replication, ms
+	};
+
+	static constexpr unsigned TICK_HISTORY = 256;
+
 	explicit Server(Urho3D::Context* context);
 	~Server();
 
@@ -40,11 +60,39 @@ public:
 
 	bool Start(unsigned short port);
 	void Stop();
+	bool RestartScene();
+	bool SaveGame(const Urho3D::String& name);
+	// Spawned player is fed from input recording instead of its connection
+	bool StartReplay(unsigned playerId, const Urho3D::String& name);
+	void StopReplay(unsigned playerId);
 
 	void MakeVisible(const Urho3D::String& serverName);
 
 	void SetPausable(bool pausable) noexcept { pausable_ = pausable; }
 	void SetUpdate(bool update);
+	void SetTickRate(unsigned tickRate);
+	void SetNetworkRate(unsigned networkRate);
+	void SetStatsInterval(float interval) noexcept { statsInterval_ = interval; }
+	void SetMaxPlayers(unsigned maxPlayers);
+	// Nodes out of radius get no updates, but Urho still sends every replicated node to every connection when it is
+	// created or removed and evaluates priorities of all nodes per connection. Zero disables interest management.
+	void SetInterestRadius(float radius);
+
+	const Urho3D::String& GetSceneName() const noexcept { return sceneName_; }
+	unsigned GetTickRate() const noexcept { return tickRate_; }
+	unsigned GetNetworkRate() const;
+	float GetStatsInterval() const noexcept { return statsInterval_; }
+	const TickStats& GetTickStats(unsigned age = 0) const;
+	unsigned GetTickStatsCount() const noexcept { return tickCount_ < TICK_HISTORY ? tickCount_ : TICK_HISTORY; }
+	unsigned GetOverruns() const noexcept { return overruns_; }
+
+	unsigned GetPlayersCount() const noexcept { return playersCount_; }
+	unsigned GetMaxPlayers() const noexcept { return maxPlayers_; }
+	unsigned GetPlayerId(const Urho3D::Connection* connection) const;
+	unsigned GetPlayerIdByNode(unsigned nodeId) const;
+	Urho3D::Connection* GetPlayerConnection(unsigned playerId) const;
+	unsigned GetPlayerNode(unsigned playerId) const;
+	float GetInterestRadius() const noexcept { return interestRadius_; }
 
 	bool IsPausable() const noexcept { return pausable_; }
 	bool IsRemote() const noexcept { return remote_; }
@@ -58,10 +106,87 @@ private:
 	void OnServerSideRespawned(Urho3D::StringHash, Urho3D::VariantMap& eventData);
 	void OnServerSideSpawned(Urho3D::StringHash, Urho3D::VariantMap& eventData);
 
+	void OnBeginFrame(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnEndFrame(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnSceneUpdate(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnScenePostUpdate(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnPhysicsPreStep(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnPhysicsPostStep(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnNetworkUpdate(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnNetworkUpdateSent(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnNodeAdded(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+	void OnAsyncLoadProgress(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+	void OnAsyncLoadFinished(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnGameSaved(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+	void OnConfigChanged(Urho3D::StringHash, Urho3D::VariantMap& eventData);
+
+	unsigned AddPlayer(Urho3D::Connection* connection);
+	void RemovePlayer(unsigned playerId);
+	void UpdateBeacon();
+	void SpawnPlayer(unsigned playerId, unsigned nodeId);
+
+	void ApplyInterest(Urho3D::Node* node);
+	void ApplyInterestAll();
+	void UpdateInterest();
+	void ResyncNodes();
+
+	bool BeginLoading(const Urho3D::String& sceneName);
+	void RestoreResourcesBudget();
+	void ApplyTickRate();
+	void TakeSnapshot();
+	void Autosave();
+	void ExcludePlayers(Urho3D::PODVector<Urho3D::Node*>& players);
+	void RestorePlayers(const Urho3D::PODVector<Urho3D::Node*>& players);
+	void LogTickStats();
+
+	struct PlayerSlot
+	{
+		Urho3D::Connection* connection_; // Null if slot is free
+		unsigned nodeId_;				 // Zero if not spawned yet
+	};
+
+	using Clock = std::chrono::steady_clock;
+
 	Urho3D::Scene scene_;
-	Urho3D::HashMap<Urho3D::StringHash, unsigned> nodes_;
+	Urho3D::String sceneName_; // Resource name, also of cached copy or saved game being loaded
+	SceneCache sceneCache_;
+	Urho3D::VectorBuffer snapshot_; // Binary scene as it was on Start()
+	Urho3D::String snapshotName_;	// Scene file name and checksum clients load on join
+	unsigned snapshotChecksum_;
+	Urho3D::VariantMap savedState_; // Plugins state of saved game being loaded
+	Urho3D::String loadingSave_;	// Saved game file being loaded
+	SceneDelta delta_;				// Changes since last autosave
+	Urho3D::PODVector<PlayerSlot> players_;								 // Player ID -> Slot
+	Urho3D::PODVector<unsigned> freeSlots_;								 // Released player IDs
+	Urho3D::HashMap<const Urho3D::Connection*, unsigned> connections_; // Connection -> Player ID
+	Urho3D::HashMap<unsigned, unsigned> playerNodes_;					 // Node ID -> Player ID
+	Urho3D::PODVector<unsigned> pendingNodes_;							 // Replicated nodes added since last update
+	Urho3D::VariantMap beacon_;
+	TickStats ticks_[TICK_HISTORY];
+	TickStats current_;
+	Clock::time_point tickStart_;
+	Clock::time_point stageStart_;
+	Clock::time_point physicsStart_;
+	Clock::time_point networkStart_;
+	Clock::time_point nextTick_;
+	Clock::time_point nextStats_;
+	Clock::time_point nextAutosave_;
+	unsigned long long loadMemory_; // Resource cache memory use before scene loading
+	int finishResourcesMs_;			// Resource cache budget before scene loading, negative if not overridden
+	unsigned tickCount_;
+	unsigned playersCount_;
+	unsigned maxPlayers_;
+	unsigned tickRate_;
+	unsigned overruns_;
+	unsigned statsOverruns_;
+	unsigned autosaveSegments_; // Deltas written since last full autosave
+	float statsInterval_;
+	float interestRadius_;
+	float autosaveInterval_;
 	bool pausable_;
 	bool remote_;
+	bool storeCache_;  // Scene being loaded is text and has no valid binary copy yet
+	bool resyncNodes_; // Scene was restarted, clients get restored nodes after removal of old ones
 };
 
 #endif // SERVER_H
@@ -23,6 +23,10 @@
 #ifndef SERVERDEFS_H
 #define SERVERDEFS_H
 
+static Urho3D::String CL_ACTIONS = "Actions";
+static Urho3D::String CL_AXES = "Axes";
+static Urho3D::String CL_INPUT_HISTORY = "InputHistory";
+static Urho3D::String CL_INPUT_SEQUENCE = "InputSequence";
 static Urho3D::String CL_NAME = "Name";
 
 static Urho3D::String SV_GAME = "Game";
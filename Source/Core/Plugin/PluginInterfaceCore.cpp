@@ -31,16 +31,32 @@ using namespace Urho3D;
 
 PluginInterfaceCore::PluginInterfaceCore(Urho3D::Context* context)
 	: PluginInterface(context)
+	, started_(false)
 {
 	SubscribeToEvent(E_CLIENTSCENELOADED, URHO3D_HANDLER(PluginInterfaceCore, OnClientSceneLoaded));
 	SubscribeToEvent(E_REMOTECLIENTSTARTED, URHO3D_HANDLER(PluginInterfaceCore, OnRemoteClientStarted));
 	SubscribeToEvent(E_REMOTECLIENTSTOPPED, URHO3D_HANDLER(PluginInterfaceCore, OnRemoteClientStopped));
+	SubscribeToEvent(E_REMOTESERVERSTARTED, URHO3D_HANDLER(PluginInterfaceCore, OnRemoteServerStarted));
+	SubscribeToEvent(E_REMOTESERVERSTOPPED, URHO3D_HANDLER(PluginInterfaceCore, OnRemoteServerStopped));
+	SubscribeToEvent(E_SCENERESTARTED, URHO3D_HANDLER(PluginInterfaceCore, OnSceneRestarted));
 }
 
 void PluginInterfaceCore::OnClientSceneLoaded(Urho3D::StringHash, Urho3D::VariantMap& eventData)
 {
 	using namespace ClientSceneLoaded;
-	Connection* connection = static_cast<Connection*>(eventData[P_CONNECTION].GetPtr());
+	SpawnClient(static_cast<Connection*>(eventData[P_CONNECTION].GetPtr()));
+}
+
+// Restored scene has no player nodes, so everyone who is already in game is spawned again
+void PluginInterfaceCore::OnSceneRestarted(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	for (Connection* connection : GetSubsystem<Network>()->GetClientConnections())
+		if (connection->IsSceneLoaded())
+			SpawnClient(connection);
+}
+
+void PluginInterfaceCore::SpawnClient(Urho3D::Connection* connection)
+{
 	Scene* scene = connection->GetScene();
 
 	const unsigned nodeId = Spawn(scene);
@@ -53,8 +69,11 @@ void PluginInterfaceCore::OnClientSceneLoaded(Urho3D::StringHash, Urho3D::Varian
 		receiver->SetTemporary(true);
 
 		using namespace ServerSideSpawned;
+		VariantMap& eventData = GetEventDataMap();
+		eventData[P_CONNECTION] = connection;
 		eventData[P_NODE] = nodeId;
 		connection->SendRemoteEvent(E_SERVERSIDESPAWNED, true, eventData);
+		SendEvent(E_SERVERSIDESPAWNED, eventData);
 	}
 }
 
@@ -62,12 +81,39 @@ void PluginInterfaceCore::OnRemoteClientStarted(Urho3D::StringHash, Urho3D::Vari
 {
 	Network* network = GetSubsystem<Network>();
 	network->RegisterRemoteEvent(E_SERVERSIDESPAWNED);
-	Start();
+	if (!started_)
+	{
+		started_ = true;
+		Start();
+	}
 }
 
 void PluginInterfaceCore::OnRemoteClientStopped(Urho3D::StringHash, Urho3D::VariantMap&)
 {
 	Network* network = GetSubsystem<Network>();
 	network->UnregisterRemoteEvent(E_SERVERSIDESPAWNED);
-	Stop();
+	if (started_)
+	{
+		started_ = false;
+		Stop();
+	}
+}
+
+// Dedicated server has no local client, so game logic is started by server itself
+void PluginInterfaceCore::OnRemoteServerStarted(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	if (!started_)
+	{
+		started_ = true;
+		Start();
+	}
+}
+
+void PluginInterfaceCore::OnRemoteServerStopped(Urho3D::StringHash, Urho3D::VariantMap&)
+{
+	if (started_)
+	{
+		started_ = false;
+		Stop();
+	}
 }
@@ -28,6 +28,7 @@
 
 namespace Urho3D
 {
+class Connection;
 class Scene;
 }
 
@@ -48,8 +49,14 @@ private:
 	void OnClientSceneLoaded(Urho3D::StringHash, Urho3D::VariantMap& eventData);
 	void OnRemoteClientStarted(Urho3D::StringHash, Urho3D::VariantMap&);
 	void OnRemoteClientStopped(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnRemoteServerStarted(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnRemoteServerStopped(Urho3D::StringHash, Urho3D::VariantMap&);
+	void OnSceneRestarted(Urho3D::StringHash, Urho3D::VariantMap&);
+
+	void SpawnClient(Urho3D::Connection* connection);
 
 	Urho3D::PODVector<Urho3D::StringHash> factories_;
+	bool started_;
 };
 
 #endif // PLUGININTERFACECORE_H
@@ -72,7 +72,7 @@ static void RegisterClasses(asIScriptEngine* engine)
 
 template <typename T> static CScriptArray* ConstructEnum(T* _ptr, StringHash parameter)
 {
-	const EnumVector result = _ptr->ConstructEnum(parameter);
+	const EnumVector& result = _ptr->ConstructEnum(parameter);
 	return VectorToArray<EnumVariant>(result, "Array<EnumVariant>");
 }
 
@@ -194,6 +194,16 @@ template <typename T> void RegisterMembers_Config(asIScriptEngine* engine, const
 								 AS_METHOD(T, ReadValue),
 								 AS_CALL_THISCALL);
 
+	engine->RegisterObjectMethod(className,
+								 "void InvalidateEnum(StringHash)",
+								 AS_METHOD(T, InvalidateEnum),
+								 AS_CALL_THISCALL);
+	engine->RegisterObjectMethod(className,
+								 "void InvalidateEnumOn(StringHash, StringHash)",
+								 AS_METHOD(T, InvalidateEnumOn),
+								 AS_CALL_THISCALL);
+	engine->RegisterObjectMethod(className, "void PrecomputeEnums()", AS_METHOD(T, PrecomputeEnums), AS_CALL_THISCALL);
+
 	// TODO: Fix creating Array<EnumVariant> contains empty data
 	engine->RegisterObjectMethod(className,
 								 "Array<EnumVariant>@ ConstructEnum(StringHash)",
@@ -238,6 +248,8 @@ template <typename T> void RegisterMembers_EnumConstructor(asIScriptEngine* engi
 								 AS_FUNCTION_OBJFIRST(EnumVector_Create<T>),
 								 AS_CALL_CDECL_OBJFIRST);
 	engine->RegisterObjectMethod(className, "bool get_localized() const", AS_METHOD(T, IsLocalized), AS_CALL_THISCALL);
+	engine->RegisterObjectMethod(
+		className, "bool get_threadSafe() const", AS_METHOD(T, IsThreadSafe), AS_CALL_THISCALL);
 }
 
 template <typename T> void RegisterMembers_EnumVariant(asIScriptEngine* engine, const char* className)
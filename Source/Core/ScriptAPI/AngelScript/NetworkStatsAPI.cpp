@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2021-2022 Yuriy Zinchenko.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/AngelScript/Generated_Members.h>
+#include "Network/NetworkStats.h"
+
+using namespace Urho3D;
+
+static NetworkStats* GetNetworkStats() { return GetScriptContext()->GetSubsystem<NetworkStats>(); }
+
+// Zero for connections without samples yet
+template <typename T> static const typename T::ConnectionStats& GetStats(T* _ptr, Connection* connection)
+{
+	static const typename T::ConnectionStats empty{};
+	const typename T::ConnectionStats* stats = _ptr->GetStats(connection);
+	return stats ? *stats : empty;
+}
+
+template <typename T> static float GetBytesIn(T* _ptr, Connection* connection)
+{
+	return GetStats(_ptr, connection).bytesIn_;
+}
+template <typename T> static float GetBytesOut(T* _ptr, Connection* connection)
+{
+	return GetStats(_ptr, connection).bytesOut_;
+}
+template <typename T> static float GetPacketsIn(T* _ptr, Connection* connection)
+{
+	return GetStats(_ptr, connection).packetsIn_;
+}
+template <typename T> static float GetPacketsOut(T* _ptr, Connection* connection)
+{
+	return GetStats(_ptr, connection).packetsOut_;
+}
+template <typename T> static float GetRoundTripTime(T* _ptr, Connection* connection)
+{
+	return GetStats(_ptr, connection).roundTripTime_;
+}
+template <typename T> static float GetLoss(T* _ptr, Connection* connection) { return GetStats(_ptr, connection).loss_; }
+template <typename T> static unsigned GetUpdateTicks(T* _ptr, Connection* connection)
+{
+	return GetStats(_ptr, connection).updateTicks_;
+}
+template <typename T> static unsigned GetMessages(T* _ptr, Connection* connection, const String& type)
+{
+	return _ptr->GetMessages(connection, type);
+}
+
+void RegisterNetworkStatsAPI(asIScriptEngine* engine)
+{
+	engine->RegisterObjectType("NetworkStats", 0, asOBJ_REF);
+
+	engine->RegisterGlobalFunction("NetworkStats@+ get_networkStats()", AS_FUNCTION(GetNetworkStats), AS_CALL_CDECL);
+
+	RegisterSubclass<Object, NetworkStats>(engine, "Object", "NetworkStats");
+	RegisterSubclass<RefCounted, NetworkStats>(engine, "RefCounted", "NetworkStats");
+
+	RegisterMembers_Object<NetworkStats>(engine, "NetworkStats");
+
+	engine->RegisterObjectMethod("NetworkStats",
+								 "float GetBytesIn(Connection@+) const",
+								 AS_FUNCTION_OBJFIRST(GetBytesIn<NetworkStats>),
+								 AS_CALL_CDECL_OBJFIRST);
+	engine->RegisterObjectMethod("NetworkStats",
+								 "float GetBytesOut(Connection@+) const",
+								 AS_FUNCTION_OBJFIRST(GetBytesOut<NetworkStats>),
+								 AS_CALL_CDECL_OBJFIRST);
+	engine->RegisterObjectMethod("NetworkStats",
+								 "float GetPacketsIn(Connection@+) const",
+								 AS_FUNCTION_OBJFIRST(GetPacketsIn<NetworkStats>),
+								 AS_CALL_CDECL_OBJFIRST);
+	engine->RegisterObjectMethod("NetworkStats",
+								 "float GetPacketsOut(Connection@+) const",
+								 AS_FUNCTION_OBJFIRST(GetPacketsOut<NetworkStats>),
+								 AS_CALL_CDECL_OBJFIRST);
+	engine->RegisterObjectMethod("NetworkStats",
+								 "float GetRoundTripTime(Connection@+) const",
+								 AS_FUNCTION_OBJFIRST(GetRoundTripTime<NetworkStats>),
+								 AS_CALL_CDECL_OBJFIRST);
+	engine->RegisterObjectMethod("NetworkStats",
+								 "float GetLoss(Connection@+) const",
+								 AS_FUNCTION_OBJFIRST(GetLoss<NetworkStats>),
+								 AS_CALL_CDECL_OBJFIRST);
+	engine->RegisterObjectMethod("NetworkStats",
+								 "uint GetUpdateTicks(Connection@+) const",
+								 AS_FUNCTION_OBJFIRST(GetUpdateTicks<NetworkStats>),
+								 AS_CALL_CDECL_OBJFIRST);
+	engine->RegisterObjectMethod("NetworkStats",
+								 "uint GetMessages(Connection@+, const String&in) const",
+								 AS_FUNCTION_OBJFIRST(GetMessages<NetworkStats>),
+								 AS_CALL_CDECL_OBJFIRST);
+
+	engine->RegisterObjectMethod("NetworkStats",
+								 "void set_debugHud(bool)",
+								 AS_METHOD(NetworkStats, SetDebugHud),
+								 AS_CALL_THISCALL);
+	engine->RegisterObjectMethod("NetworkStats",
+								 "bool get_debugHud() const",
+								 AS_METHOD(NetworkStats, IsDebugHud),
+								 AS_CALL_THISCALL);
+}
@@ -23,12 +23,14 @@
 class asIScriptEngine;
 
 extern void RegisterConfigAPI(asIScriptEngine* engine);
+extern void RegisterNetworkStatsAPI(asIScriptEngine* engine);
 extern void RegisterPluginsRegistryAPI(asIScriptEngine* engine);
 extern void RegisterShellConfiguratorAPI(asIScriptEngine* engine);
 
 void RegisterServerAPI(asIScriptEngine* engine)
 {
 	RegisterConfigAPI(engine);
+	RegisterNetworkStatsAPI(engine);
 	RegisterPluginsRegistryAPI(engine);
 	RegisterShellConfiguratorAPI(engine);
 }
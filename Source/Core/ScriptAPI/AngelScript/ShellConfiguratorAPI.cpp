@@ -65,6 +65,14 @@ void RegisterShellConfiguratorAPI(asIScriptEngine* engine)
 								 AS_METHOD(ShellConfigurator, RemoveProfile),
 								 AS_CALL_THISCALL);
 
+	engine->RegisterObjectMethod("ShellConfigurator",
+								 "String get_binaryConfigFilename() const",
+								 AS_METHOD(ShellConfigurator, GetBinaryConfigFilename),
+								 AS_CALL_THISCALL);
+	engine->RegisterObjectMethod("ShellConfigurator",
+								 "String get_cachePath() const",
+								 AS_METHOD(ShellConfigurator, GetCachePath),
+								 AS_CALL_THISCALL);
 	engine->RegisterObjectMethod("ShellConfigurator",
 								 "String get_configFilename() const",
 								 AS_METHOD(ShellConfigurator, GetConfigFilename),
@@ -93,6 +101,10 @@ void RegisterShellConfiguratorAPI(asIScriptEngine* engine)
 								 "String get_profileFilename() const",
 								 AS_METHOD(ShellConfigurator, GetProfileFilename),
 								 AS_CALL_THISCALL);
+	engine->RegisterObjectMethod("ShellConfigurator",
+								 "String get_recordingsPath() const",
+								 AS_METHOD(ShellConfigurator, GetRecordingsPath),
+								 AS_CALL_THISCALL);
 	engine->RegisterObjectMethod("ShellConfigurator",
 								 "String get_savesPath() const",
 								 AS_METHOD(ShellConfigurator, GetSavesPath),
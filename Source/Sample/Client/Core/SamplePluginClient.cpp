@@ -27,6 +27,7 @@
 #include <Urho3D/Input/InputConstants.h>
 #include <Urho3D/Scene/Scene.h>
 #include "Core/ActionsDefs.h"
+#include "Core/SampleActorController.h"
 #include "Input/ControllersRegistry.h"
 #include "Plugin/BinaryPluginUtils.h"
 #include "SamplePluginClient.h"
@@ -56,6 +57,7 @@ void SamplePluginClient::Spawn(Urho3D::Scene* scene, unsigned nodeId)
 	URHO3D_LOGTRACE("SamplePluginClient::Spawn");
 
 	Node* node = scene->GetNode(nodeId);
+	node->CreateComponent<SampleActorController>(LOCAL); // Predicted locally
 	Camera* camera = node->CreateComponent<Camera>();
 	camera->SetTemporary(true);
 	SharedPtr<Viewport> viewport = MakeShared<Viewport>(context_, scene, camera);